@@ -0,0 +1,96 @@
+#ifndef BINDINGS_HPP
+#define BINDINGS_HPP
+/*
+    Description: Flat keyboard binding table shared by the examples.
+        Bindings live in an array indexed by sf::Keyboard::Key, with a short list of the
+        bound keys for iteration, so binding lookups are a single index and nothing is
+        allocated per binding. Values are plain data (an enum, a function pointer).
+        KeyState is one bit per key; Keyboard samples the OS once per frame for only the
+        keys some table binds, and tables dispatch from that state instead of querying.
+*/
+#include <SFML/Window/Keyboard.hpp>
+#include <array>
+#include <bitset>
+#include <cstddef>
+
+namespace my {
+    typedef std::bitset<sf::Keyboard::KeyCount> KeyState;
+
+    template <typename Value>
+    class BindingTable {
+    private:
+        std::array<Value, sf::Keyboard::KeyCount> values;
+        std::array<sf::Keyboard::Key, sf::Keyboard::KeyCount> keys;//Bound keys, first count used.
+        std::size_t count;
+        KeyState mask;
+        static bool valid(sf::Keyboard::Key key) {
+            return key >= 0 && key < sf::Keyboard::KeyCount;
+        }
+    public:
+        BindingTable() : values{}, keys{}, count{ 0 } {}
+        void bind(sf::Keyboard::Key key, const Value& value) {
+            if (!valid(key))
+                return;
+            if (!mask[key])
+                keys[count++] = key;
+            mask[key] = true;
+            values[key] = value;
+        }
+        void unbind(sf::Keyboard::Key key) {
+            if (!valid(key) || !mask[key])
+                return;
+            mask[key] = false;
+            for (std::size_t i = 0; i < count; ++i)
+                if (keys[i] == key) {
+                    keys[i] = keys[--count];
+                    break;
+                }
+        }
+        bool isBound(sf::Keyboard::Key key) const {
+            return valid(key) && mask[key];
+        }
+        //Value bound to key; only meaningful when isBound(key).
+        const Value& get(sf::Keyboard::Key key) const {
+            return values[key];
+        }
+        //Every bound key, for sampling.
+        const KeyState& getMask() const {
+            return mask;
+        }
+        std::size_t size() const {
+            return count;
+        }
+        //Calls f(key, value) for each bound key held down in state.
+        template <typename F>
+        void forEachHeld(const KeyState& state, F f) const {
+            for (std::size_t i = 0; i < count; ++i)
+                if (state[keys[i]])
+                    f(keys[i], values[keys[i]]);
+        }
+        //Calls f(key, value, pressed) for each bound key that changed between two states.
+        template <typename F>
+        void forEachChanged(const KeyState& state, const KeyState& previous, F f) const {
+            for (std::size_t i = 0; i < count; ++i)
+                if (state[keys[i]] != previous[keys[i]])
+                    f(keys[i], values[keys[i]], state[keys[i]]);
+        }
+    };
+
+    //Keyboard state sampled once per frame.
+    class Keyboard {
+    public:
+        KeyState state, previous;
+        //Query the OS for the keys in mask only; every other key reads as released.
+        void sample(const KeyState& mask) {
+            previous = state;
+            state.reset();
+            for (std::size_t key = 0; key < mask.size(); ++key)
+                if (mask[key])
+                    state[key] = sf::Keyboard::isKeyPressed(static_cast<sf::Keyboard::Key>(key));
+        }
+        bool isDown(sf::Keyboard::Key key) const {
+            return key >= 0 && key < sf::Keyboard::KeyCount && state[key];
+        }
+    };
+}
+#endif // !BINDINGS_HPP
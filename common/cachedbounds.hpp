@@ -0,0 +1,123 @@
+#ifndef CACHEDBOUNDS_HPP
+#define CACHEDBOUNDS_HPP
+/*
+    Description: Mixin caching a shape's world bounds, shared by the examples.
+        sf::Shape::getGlobalBounds builds the transform and transforms the local bounds on
+        every call. CachedBounds<Shape> derives from an SFML shape, hides the setters that
+        move or reshape it so each one marks the bounds dirty, and getGlobalBounds only
+        recomputes after such a change. Counters report recomputes against cache hits.
+        The setters are hidden, not overridden (SFML's are not virtual): calls made through
+        an sf::Shape or sf::Transformable pointer skip the cache, so call through the
+        derived type, or invalidate() after changing the shape some other way.
+
+    Usage:
+        class Wall : public my::CachedBounds<sf::RectangleShape> { ... };
+*/
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <utility>
+
+namespace my {
+    template<class Shape>
+    class CachedBounds : public Shape {
+    private:
+        mutable sf::FloatRect bounds;
+        mutable bool dirty;
+    public:
+        mutable std::size_t boundsHits, boundsRecomputes;
+        //Forwards to the shape's constructor.
+        template<class... Args>
+        CachedBounds(Args&&... args) :
+            Shape(std::forward<Args>(args)...), dirty{ true }, boundsHits{ 0 }, boundsRecomputes{ 0 } {}
+        CachedBounds(const CachedBounds&) = default;
+        CachedBounds(CachedBounds&&) = default;
+        //A non-const lvalue would pick the forwarding constructor over the copy constructor.
+        CachedBounds(CachedBounds& other) : CachedBounds(static_cast<const CachedBounds&>(other)) {}
+        CachedBounds& operator=(const CachedBounds&) = default;
+        CachedBounds& operator=(CachedBounds&&) = default;
+
+        //Next getGlobalBounds recomputes.
+        void invalidate() {
+            dirty = true;
+        }
+        sf::FloatRect getGlobalBounds() const {
+            if (dirty) {
+                bounds = Shape::getGlobalBounds();
+                dirty = false;
+                ++boundsRecomputes;
+            }
+            else
+                ++boundsHits;
+            return bounds;
+        }
+
+        //Transform
+        void setPosition(float x, float y) {
+            Shape::setPosition(x, y);
+            dirty = true;
+        }
+        void setPosition(const sf::Vector2f& position) {
+            Shape::setPosition(position);
+            dirty = true;
+        }
+        void setRotation(float angle) {
+            Shape::setRotation(angle);
+            dirty = true;
+        }
+        void setScale(float x, float y) {
+            Shape::setScale(x, y);
+            dirty = true;
+        }
+        void setScale(const sf::Vector2f& factors) {
+            Shape::setScale(factors);
+            dirty = true;
+        }
+        void setOrigin(float x, float y) {
+            Shape::setOrigin(x, y);
+            dirty = true;
+        }
+        void setOrigin(const sf::Vector2f& origin) {
+            Shape::setOrigin(origin);
+            dirty = true;
+        }
+        void move(float x, float y) {
+            Shape::move(x, y);
+            dirty = true;
+        }
+        void move(const sf::Vector2f& offset) {
+            Shape::move(offset);
+            dirty = true;
+        }
+        void rotate(float angle) {
+            Shape::rotate(angle);
+            dirty = true;
+        }
+        void scale(float x, float y) {
+            Shape::scale(x, y);
+            dirty = true;
+        }
+        void scale(const sf::Vector2f& factors) {
+            Shape::scale(factors);
+            dirty = true;
+        }
+
+        //Local geometry: only instantiated for shapes that have them.
+        void setOutlineThickness(float thickness) {
+            Shape::setOutlineThickness(thickness);
+            dirty = true;
+        }
+        void setSize(const sf::Vector2f& size) {
+            Shape::setSize(size);
+            dirty = true;
+        }
+        void setRadius(float radius) {
+            Shape::setRadius(radius);
+            dirty = true;
+        }
+        void setPointCount(std::size_t count) {
+            Shape::setPointCount(count);
+            dirty = true;
+        }
+    };
+}
+#endif // !CACHEDBOUNDS_HPP
@@ -0,0 +1,70 @@
+#ifndef CAMERA_HPP
+#define CAMERA_HPP
+/*
+    Description: Camera over sf::View, shared by the examples. Holds the view a window draws
+        through and the world rectangle it shows, so a draw pass can ask its spatial index
+        for what is on screen instead of submitting everything. Also keeps the visible and
+        total counts of the last cull for reporting.
+
+    Usage:
+        my::Camera camera{ { 0, 0, 800, 600 } };
+        camera.follow(player.getPosition());
+        index.query(camera.getBounds(), visible);
+        camera.count(visible.size(), total);
+        camera.apply(window);
+*/
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <cstddef>
+
+namespace my {
+    class Camera {
+    private:
+        sf::View view;
+    public:
+        std::size_t visible, total;//Kept by the last cull, out of how many.
+        explicit Camera(const sf::FloatRect& area) : view{ area }, visible{ 0 }, total{ 0 } {}
+        void setCenter(const sf::Vector2f& center) {
+            view.setCenter(center);
+        }
+        //Moves rate of the way towards target: 1 snaps to it.
+        void follow(const sf::Vector2f& target, float rate = 1.f) {
+            view.setCenter(view.getCenter() + (target - view.getCenter()) * rate);
+        }
+        //Factors above 1 show more of the world, below 1 less.
+        void zoom(float factor) {
+            view.zoom(factor);
+        }
+        void reset(const sf::FloatRect& area) {
+            view.reset(area);
+        }
+        const sf::View& getView() const {
+            return view;
+        }
+        void apply(sf::RenderTarget& target) const {
+            target.setView(view);
+        }
+        //World area on screen: bounds of the view rectangle, rotation included.
+        sf::FloatRect getBounds() const {
+            return getBounds(view);
+        }
+        //The same for any view, e.g. a render target's current one.
+        static sf::FloatRect getBounds(const sf::View& view) {
+            const sf::Vector2f& center = view.getCenter();
+            sf::Vector2f half = view.getSize() / 2.f;
+            float angle = view.getRotation() * 3.141592654f / 180.f,
+                  cos = std::abs(std::cos(angle)), sin = std::abs(std::sin(angle)),
+                  x = half.x * cos + half.y * sin,
+                  y = half.x * sin + half.y * cos;
+            return sf::FloatRect{ center.x - x, center.y - y, x * 2, y * 2 };
+        }
+        bool sees(const sf::FloatRect& box) const {
+            return getBounds().intersects(box);
+        }
+        void count(std::size_t visible, std::size_t total) {
+            this->visible = visible;
+            this->total = total;
+        }
+    };
+}
+#endif // !CAMERA_HPP
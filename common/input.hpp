@@ -0,0 +1,70 @@
+#ifndef INPUT_HPP
+#define INPUT_HPP
+/*
+    Description: Event-driven keyboard state shared by the examples.
+        Key state is built from KeyPressed/KeyReleased events as they are polled, so the
+        OS is never queried. Once per frame snapshot() hands the update step a compact,
+        copyable KeySnapshot with edges: keys pressed or released since the last frame.
+        A press and release inside one frame still shows up as pressed this frame.
+        Snapshots are plain bitsets, so they can be stored and replayed as they are.
+*/
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Keyboard.hpp>
+#include "bindings.hpp"
+
+namespace my {
+    struct KeySnapshot {
+        KeyState down, pressed, released;
+        bool isDown(sf::Keyboard::Key key) const {
+            return valid(key) && down[key];
+        }
+        bool wasPressed(sf::Keyboard::Key key) const {
+            return valid(key) && pressed[key];
+        }
+        bool wasReleased(sf::Keyboard::Key key) const {
+            return valid(key) && released[key];
+        }
+        static bool valid(sf::Keyboard::Key key) {
+            return key >= 0 && key < sf::Keyboard::KeyCount;
+        }
+    };
+
+    class InputState {
+    private:
+        KeyState down, pressed, released;
+    public:
+        //Feed every polled event; returns true if it was a keyboard event.
+        bool handle(const sf::Event& event) {
+            if (event.type != sf::Event::KeyPressed && event.type != sf::Event::KeyReleased)
+                return false;
+            sf::Keyboard::Key key = event.key.code;
+            if (!KeySnapshot::valid(key))
+                return true;
+            if (event.type == sf::Event::KeyPressed) {
+                //Key repeat sends more KeyPressed events: only the first one is an edge.
+                if (!down[key])
+                    pressed[key] = true;
+                down[key] = true;
+            }
+            else {
+                if (down[key])
+                    released[key] = true;
+                down[key] = false;
+            }
+            return true;
+        }
+        //Window lost focus: releases are never delivered, so drop every held key.
+        void releaseAll() {
+            released |= down;
+            down.reset();
+        }
+        //State of this frame, then clears the edges for the next one.
+        KeySnapshot snapshot() {
+            KeySnapshot result{ down | pressed, pressed, released };
+            pressed.reset();
+            released.reset();
+            return result;
+        }
+    };
+}
+#endif // !INPUT_HPP
@@ -0,0 +1,165 @@
+#ifndef JOBS_HPP
+#define JOBS_HPP
+/*
+    Description: Fixed pool of worker threads with work-stealing deques, shared by the examples.
+        parallelFor hands the whole range to the calling thread as one job. Whoever runs a
+        job larger than grain splits it in half, keeps the lower half and pushes the upper
+        half onto the back of its own deque. Owners pop from the back (newest, smallest,
+        still in cache), idle threads steal from the front of other deques (oldest, largest),
+        so work spreads out in a few steals instead of one queue everyone fights over.
+        The calling thread works too and returns once every piece of the range has run.
+        Jobs hold a function pointer and a range: nothing is allocated per job.
+
+    Usage:
+        my::JobSystem jobs;
+        jobs.parallelFor(count, 4096, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) update(i);
+        });
+*/
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace my {
+    class JobSystem {
+    private:
+        struct Job {
+            void (*call)(const void* body, std::size_t begin, std::size_t end);
+            const void* body;
+            std::size_t begin, end, grain;
+            std::atomic<std::size_t>* pending;
+        };
+        //Owner works the back, thieves take the front.
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+        };
+        //Queue 0 belongs to the thread calling parallelFor, the rest to workers.
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::thread> workers;
+        std::mutex sleep;
+        std::condition_variable wake;
+        std::atomic<std::size_t> queued, sleeping;
+        bool stopping;
+
+        void push(std::size_t self, const Job& job) {
+            //Counted first, so queued never reads lower than the jobs really waiting.
+            ++queued;
+            {
+                std::lock_guard<std::mutex> lock{ queues[self]->mutex };
+                queues[self]->jobs.push_back(job);
+            }
+            if (sleeping) {
+                std::lock_guard<std::mutex> lock{ sleep };
+                wake.notify_one();
+            }
+        }
+        bool take(std::size_t self, Job& job) {
+            if (!queued)
+                return false;
+            for (std::size_t i = 0; i < queues.size(); ++i) {
+                std::size_t victim = (self + i) % queues.size();
+                std::lock_guard<std::mutex> lock{ queues[victim]->mutex };
+                std::deque<Job>& jobs = queues[victim]->jobs;
+                if (jobs.empty())
+                    continue;
+                if (victim == self) {
+                    job = jobs.back();
+                    jobs.pop_back();
+                }
+                else {
+                    job = jobs.front();
+                    jobs.pop_front();
+                    ++steals;
+                }
+                --queued;
+                return true;
+            }
+            return false;
+        }
+        void execute(std::size_t self, Job job) {
+            while (job.end - job.begin > job.grain) {
+                Job half = job;
+                half.begin = job.begin + (job.end - job.begin) / 2;
+                job.end = half.begin;
+                job.pending->fetch_add(1);
+                push(self, half);
+            }
+            job.call(job.body, job.begin, job.end);
+            job.pending->fetch_sub(1, std::memory_order_release);
+        }
+        void work(std::size_t self) {
+            Job job;
+            for (;;) {
+                if (take(self, job)) {
+                    execute(self, job);
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock{ sleep };
+                ++sleeping;
+                wake.wait(lock, [this] { return stopping || queued > 0; });
+                --sleeping;
+                if (stopping && !queued)
+                    return;
+            }
+        }
+        template<class Body>
+        static void call(const void* body, std::size_t begin, std::size_t end) {
+            (*static_cast<const Body*>(body))(begin, end);
+        }
+    public:
+        std::atomic<std::size_t> steals;    //Jobs taken from another thread's deque since construction.
+
+        //threads: workers besides the calling thread, default one per spare core.
+        explicit JobSystem(unsigned threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() - 1 : 0) :
+            queued{ 0 }, sleeping{ 0 }, stopping{ false }, steals{ 0 } {
+            for (unsigned i = 0; i <= threads; ++i)
+                queues.push_back(std::unique_ptr<Queue>{ new Queue });
+            for (unsigned i = 1; i <= threads; ++i)
+                workers.push_back(std::thread{ &JobSystem::work, this, static_cast<std::size_t>(i) });
+        }
+        ~JobSystem() {
+            {
+                std::lock_guard<std::mutex> lock{ sleep };
+                stopping = true;
+            }
+            wake.notify_all();
+            for (auto& worker : workers)
+                worker.join();
+        }
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        //Threads running jobs, the caller included.
+        std::size_t getThreadCount() const {
+            return queues.size();
+        }
+        //Calls body(begin, end) over pieces of [0, count) no larger than grain, in parallel.
+        //Call from one thread at a time; body must not call parallelFor itself.
+        template<class Body>
+        void parallelFor(std::size_t count, std::size_t grain, const Body& body) {
+            if (!grain)
+                grain = 1;
+            if (workers.empty() || count <= grain) {
+                body(std::size_t{ 0 }, count);
+                return;
+            }
+            std::atomic<std::size_t> pending{ 1 };
+            execute(0, Job{ &JobSystem::call<Body>, &body, 0, count, grain, &pending });
+            //Help until the last piece, wherever it ran, has finished.
+            Job job;
+            while (pending.load(std::memory_order_acquire)) {
+                if (take(0, job))
+                    execute(0, job);
+                else
+                    std::this_thread::yield();
+            }
+        }
+    };
+}
+#endif // !JOBS_HPP
@@ -0,0 +1,58 @@
+#ifndef KINEMATIC_HPP
+#define KINEMATIC_HPP
+/*
+    Description: Moving shape mixin, shared by the examples. Kinematic<Shape> layers a velocity
+        over CachedBounds<Shape>, so each concrete shape gets its velocity, accessors and update
+        from the template instead of repeating them. Nothing here is virtual: stepping a
+        container of one concrete type binds every call at compile time, and the loop in
+        my::step is instantiated per type.
+        Leave getPointCount/getPoint alone in derived shapes: SFML already implements them, and
+        overriding only to forward adds a call per point whenever SFML rebuilds the geometry.
+
+    Usage:
+        class Ball : public my::Kinematic<sf::CircleShape> { ... };
+        my::step(balls, delta);
+*/
+#include <SFML/Graphics.hpp>
+#include <utility>
+#include "cachedbounds.hpp"
+
+namespace my {
+    template<class Shape>
+    class Kinematic : public CachedBounds<Shape> {
+    public:
+        sf::Vector2f velocity;//Distance per unit of step()'s delta: per second in ex_2, per update step in Pong.
+        //Forwards to the shape's constructor; starts at rest.
+        template<class... Args>
+        Kinematic(Args&&... args) :
+            CachedBounds<Shape>(std::forward<Args>(args)...), velocity{ 0, 0 } {}
+        Kinematic(const Kinematic&) = default;
+        Kinematic(Kinematic&&) = default;
+        //A non-const lvalue would pick the forwarding constructor over the copy constructor.
+        Kinematic(Kinematic& other) : Kinematic(static_cast<const Kinematic&>(other)) {}
+        Kinematic& operator=(const Kinematic&) = default;
+        Kinematic& operator=(Kinematic&&) = default;
+
+        void setVelocity(float x, float y) {
+            velocity = { x, y };
+        }
+        void setVelocity(const sf::Vector2f& velocity) {
+            this->velocity = velocity;
+        }
+        const sf::Vector2f& getVelocity() const {
+            return velocity;
+        }
+        //Moves by velocity times delta.
+        void step(float delta) {
+            this->move(velocity.x * delta, velocity.y * delta);
+        }
+    };
+
+    //Steps every shape of a container of one concrete type.
+    template<class Range>
+    void step(Range& shapes, float delta) {
+        for (auto& shape : shapes)
+            shape.step(delta);
+    }
+}
+#endif // !KINEMATIC_HPP
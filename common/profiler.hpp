@@ -0,0 +1,192 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+/*
+    Description: Lightweight frame profiler shared by the examples.
+        Scoped timers add the time spent in each phase (events, update, draw, sleep) to
+        the current frame; endFrame publishes the frame into a fixed size ring buffer.
+        The ring has one writer (the game loop) and any number of readers: each slot is
+        guarded by a sequence number, so neither side ever takes a lock.
+        Summaries give min/avg/p99 per phase; dumps write CSV or Chrome trace JSON
+        (load in chrome://tracing or ui.perfetto.dev).
+*/
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace my {
+    struct Phase {
+        enum Id {
+            Events,
+            Update,
+            Draw,
+            Sleep,
+            Count
+        };
+        static const char* name(std::size_t id) {
+            static const char* names[Count] = { "events", "update", "draw", "sleep" };
+            return id < Count ? names[id] : "frame";
+        }
+    };
+
+    class Profiler {
+    public:
+        typedef std::chrono::steady_clock Clock;
+        //One published frame, times in microseconds since the profiler was created.
+        struct Frame {
+            std::uint64_t index;
+            std::int64_t start, total;
+            std::array<std::int64_t, Phase::Count> begin, duration;
+        };
+        struct Summary {
+            double min, avg, p99;
+        };
+        //Adds the time until it goes out of scope to a phase of the current frame.
+        class Scope {
+        private:
+            Profiler& profiler;
+            Phase::Id phase;
+            Clock::time_point start;
+        public:
+            Scope(Profiler& profiler, Phase::Id phase) : profiler(profiler), phase{ phase }, start{ Clock::now() } {}
+            ~Scope() { profiler.add(phase, start, Clock::now()); }
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+        };
+    private:
+        struct Slot {
+            std::atomic<std::uint64_t> sequence;//Odd while being written.
+            std::atomic<std::int64_t> index, start, total;
+            std::array<std::atomic<std::int64_t>, Phase::Count> begin, duration;
+        };
+        std::vector<Slot> slots;
+        std::atomic<std::uint64_t> written;
+        Clock::time_point epoch, frame_start;
+        Frame current;
+        std::int64_t micros(Clock::time_point time) const {
+            return std::chrono::duration_cast<std::chrono::microseconds>(time - epoch).count();
+        }
+    public:
+        Profiler(std::size_t capacity = 1024) : slots(capacity ? capacity : 1), written{ 0 },
+            epoch{ Clock::now() }, frame_start{ epoch }, current{} {
+            for (auto& slot : slots)
+                slot.sequence.store(0, std::memory_order_relaxed);
+        }
+        void beginFrame() {
+            frame_start = Clock::now();
+            current.start = micros(frame_start);
+            current.begin.fill(-1);
+            current.duration.fill(0);
+        }
+        void add(Phase::Id phase, Clock::time_point start, Clock::time_point end) {
+            if (current.begin[phase] < 0)
+                current.begin[phase] = micros(start);
+            current.duration[phase] += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        }
+        //Publish the current frame, overwriting the oldest once the ring is full.
+        void endFrame() {
+            std::uint64_t index = written.load(std::memory_order_relaxed);
+            Slot& slot = slots[index % slots.size()];
+            std::uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+            slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.index.store(static_cast<std::int64_t>(index), std::memory_order_relaxed);
+            slot.start.store(current.start, std::memory_order_relaxed);
+            slot.total.store(micros(Clock::now()) - current.start, std::memory_order_relaxed);
+            for (std::size_t phase = 0; phase < Phase::Count; ++phase) {
+                slot.begin[phase].store(current.begin[phase], std::memory_order_relaxed);
+                slot.duration[phase].store(current.duration[phase], std::memory_order_relaxed);
+            }
+            slot.sequence.store(sequence + 2, std::memory_order_release);
+            written.store(index + 1, std::memory_order_release);
+        }
+        //Copy of the frames still in the ring, oldest first. Frames mid-write are skipped.
+        std::vector<Frame> frames() const {
+            std::uint64_t end = written.load(std::memory_order_acquire),
+                          first = end > slots.size() ? end - slots.size() : 0;
+            std::vector<Frame> result;
+            result.reserve(static_cast<std::size_t>(end - first));
+            for (std::uint64_t index = first; index < end; ++index) {
+                const Slot& slot = slots[index % slots.size()];
+                std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+                Frame frame;
+                frame.index = static_cast<std::uint64_t>(slot.index.load(std::memory_order_relaxed));
+                frame.start = slot.start.load(std::memory_order_relaxed);
+                frame.total = slot.total.load(std::memory_order_relaxed);
+                for (std::size_t phase = 0; phase < Phase::Count; ++phase) {
+                    frame.begin[phase] = slot.begin[phase].load(std::memory_order_relaxed);
+                    frame.duration[phase] = slot.duration[phase].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (before % 2 || before != slot.sequence.load(std::memory_order_relaxed) || frame.index != index)
+                    continue;
+                result.push_back(frame);
+            }
+            return result;
+        }
+        //Microsecond statistics of one phase, or of whole frames for Phase::Count.
+        Summary summarize(std::size_t phase) const {
+            std::vector<Frame> samples = frames();
+            if (samples.empty())
+                return Summary{ 0, 0, 0 };
+            std::vector<std::int64_t> values;
+            values.reserve(samples.size());
+            for (const auto& frame : samples)
+                values.push_back(phase < Phase::Count ? frame.duration[phase] : frame.total);
+            std::size_t p99 = (values.size() - 1) * 99 / 100;
+            std::nth_element(values.begin(), values.begin() + p99, values.end());
+            double sum = 0;
+            for (auto value : values)
+                sum += static_cast<double>(value);
+            return Summary{ static_cast<double>(*std::min_element(values.begin(), values.end())),
+                            sum / values.size(), static_cast<double>(values[p99]) };
+        }
+        //One line per phase and for the whole frame: min/avg/p99 in milliseconds.
+        void print(std::ostream& out) const {
+            for (std::size_t phase = 0; phase <= Phase::Count; ++phase) {
+                Summary summary = summarize(phase);
+                out << Phase::name(phase) << " min/avg/p99 ms: " << summary.min / 1000 << ' '
+                    << summary.avg / 1000 << ' ' << summary.p99 / 1000 << '\n';
+            }
+        }
+        bool writeCsv(const std::string& filename) const {
+            std::ofstream file(filename);
+            file << "frame,start_us";
+            for (std::size_t phase = 0; phase < Phase::Count; ++phase)
+                file << ',' << Phase::name(phase) << "_us";
+            file << ",total_us\n";
+            for (const auto& frame : frames()) {
+                file << frame.index << ',' << frame.start;
+                for (auto duration : frame.duration)
+                    file << ',' << duration;
+                file << ',' << frame.total << '\n';
+            }
+            return file.good();
+        }
+        //Chrome trace event format: one complete ("X") event per frame and per phase.
+        bool writeTrace(const std::string& filename) const {
+            std::ofstream file(filename);
+            file << "{\"traceEvents\":[";
+            bool first = true;
+            auto event = [&](const char* name, std::int64_t start, std::int64_t duration, int tid) {
+                file << (first ? "" : ",") << "\n{\"name\":\"" << name << "\",\"ph\":\"X\",\"ts\":" << start
+                     << ",\"dur\":" << duration << ",\"pid\":0,\"tid\":" << tid << '}';
+                first = false;
+            };
+            for (const auto& frame : frames()) {
+                event("frame", frame.start, frame.total, 0);
+                for (std::size_t phase = 0; phase < Phase::Count; ++phase)
+                    if (frame.begin[phase] >= 0)
+                        event(Phase::name(phase), frame.begin[phase], frame.duration[phase], 1);
+            }
+            file << "\n]}\n";
+            return file.good();
+        }
+    };
+}
+#endif // !PROFILER_HPP
@@ -0,0 +1,92 @@
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+/*
+    Description: Fixed timestep game loop scheduler shared by the examples.
+        Updates always run with the same step. Time left over is carried to the next
+        frame, so several steps run back to back when a frame was late (catch up), but
+        never more than maxSteps: the rest is dropped to avoid the spiral of death.
+        Draws are paced to dps and get an alpha to interpolate between the last two
+        updates. wait sleeps until the next update or draw is due, not a fixed time.
+
+    Usage:
+        while (running) {
+            std::size_t steps = scheduler.advance();
+            //poll events
+            while (steps--) update(scheduler.getStep());
+            if (scheduler.drawDue()) draw(scheduler.getAlpha());
+            scheduler.wait();
+        }
+*/
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+namespace my {
+    class Scheduler {
+    public:
+        typedef std::chrono::steady_clock Clock;
+    private:
+        Clock::duration step, frame, accumulator;
+        Clock::time_point last, next_draw;
+        std::size_t max_steps;
+    public:
+        float delta;        //Seconds elapsed between the last two calls to advance.
+        std::size_t dropped;//Steps skipped by the maxSteps cap since construction.
+        //ups: updates per second, dps: draws per second (0 draws every frame).
+        Scheduler(float ups = 120.f, float dps = 60.f, std::size_t maxSteps = 5) :
+            step{ std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(1 / ups)) },
+            frame{ dps > 0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(1 / dps))
+                           : Clock::duration::zero() },
+            accumulator{ Clock::duration::zero() },
+            last{ Clock::now() }, next_draw{ last },
+            max_steps{ maxSteps ? maxSteps : 1 }, delta{ 0 }, dropped{ 0 } {
+        }
+        //Accumulate time since the last frame, returns the number of updates to run now.
+        std::size_t advance() {
+            Clock::time_point now = Clock::now();
+            accumulator += now - last;
+            delta = std::chrono::duration<float>(now - last).count();
+            last = now;
+            std::size_t steps = static_cast<std::size_t>(accumulator / step);
+            if (steps > max_steps) {
+                dropped += steps - max_steps;
+                steps = max_steps;
+                accumulator = accumulator % step + step * max_steps;
+            }
+            accumulator -= step * steps;
+            return steps;
+        }
+        //Seconds per update: the delta every update should use.
+        float getStep() const {
+            return std::chrono::duration<float>(step).count();
+        }
+        //How far between the last update and the next one this frame is, [0, 1).
+        float getAlpha() const {
+            return std::chrono::duration<float>(accumulator).count() / getStep();
+        }
+        //True once per draw period; reschedules the next draw.
+        bool drawDue() {
+            Clock::time_point now = Clock::now();
+            if (now < next_draw)
+                return false;
+            next_draw += frame;
+            if (next_draw < now)
+                next_draw = now + frame;//Fell behind: don't burst draws to catch up.
+            return true;
+        }
+        //Sleep until the next update or draw deadline, whichever comes first.
+        void wait() const {
+            Clock::time_point update = last + (step - accumulator),
+                              draw = frame > Clock::duration::zero() ? next_draw : update;
+            std::this_thread::sleep_until(std::min(update, draw));
+        }
+    };
+
+    //Linear interpolation for drawing between two update states.
+    template <typename T>
+    T lerp(const T& previous, const T& current, float alpha) {
+        return previous + (current - previous) * alpha;
+    }
+}
+#endif // !SCHEDULER_HPP
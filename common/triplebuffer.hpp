@@ -0,0 +1,57 @@
+#ifndef TRIPLEBUFFER_HPP
+#define TRIPLEBUFFER_HPP
+/*
+    Description: Lock-free triple buffer handing whole values from one producer thread
+        to one consumer thread, shared by the examples.
+        The producer fills back() and publishes it; the consumer takes the newest
+        published value with update() and reads front(). The third buffer sits in the
+        middle, so neither side ever waits for the other: the producer overwrites
+        values the consumer skipped, the consumer keeps its front until something newer.
+        Buffers are reused, so values holding vectors stop allocating once warmed up.
+
+    Usage:
+        //Producer
+        buffer.back() = state;
+        buffer.publish();
+        //Consumer
+        buffer.update();
+        draw(buffer.front());
+*/
+#include <atomic>
+#include <cstdint>
+
+namespace my {
+    template<class T>
+    class TripleBuffer {
+    private:
+        static const std::uint8_t fresh = 4;//Set in middle while it holds an unread value.
+        T buffers[3];
+        std::atomic<std::uint8_t> middle;
+        std::uint8_t front_index, back_index;
+    public:
+        TripleBuffer() : middle{ 1 }, front_index{ 0 }, back_index{ 2 } {}
+        TripleBuffer(const TripleBuffer&) = delete;
+        TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+        //Producer: the buffer to fill next, its old contents are stale.
+        T& back() {
+            return buffers[back_index];
+        }
+        //Producer: make back() the newest value and take another buffer to fill.
+        void publish() {
+            back_index = middle.exchange(static_cast<std::uint8_t>(back_index | fresh), std::memory_order_acq_rel) & 3;
+        }
+        //Consumer: move to the newest published value, false when there is none since last time.
+        bool update() {
+            if (!(middle.load(std::memory_order_relaxed) & fresh))
+                return false;
+            front_index = middle.exchange(front_index, std::memory_order_acq_rel) & 3;
+            return true;
+        }
+        //Consumer: the value taken by the last update().
+        const T& front() const {
+            return buffers[front_index];
+        }
+    };
+}
+#endif // !TRIPLEBUFFER_HPP
@@ -23,6 +23,9 @@
 #include <unordered_map>//Unordered map: holds a key pair that can be accessed with 
                         //first and second variable names. This object is being used
                         //to map our input state with preset SFML enumerators.
+#include "../common/scheduler.hpp"//Fixed timestep loop: update catch-up, draw pacing, sleeping.
+#include "../common/profiler.hpp" //Per phase frame timings: events, update, draw, sleep.
+#include "../common/input.hpp"    //Key state built from events, read once per frame.
 
 int main() {
     //Bind our input map on construction with key(int) and value(bool).
@@ -37,9 +40,6 @@ int main() {
     //Declare the Window and set the video mode and title.
     sf::RenderWindow window(sf::VideoMode(200, 200), "SFML works!");
 
-    //Create a clock to acquire delta time per cycle of loop.
-    sf::Clock clock;
-
     //Two SFML vectors to maintain our shape size and velocity.
     sf::Vector2<float> size(50,50), velocity(100,100);
 
@@ -48,28 +48,33 @@ int main() {
     shape.setFillColor(sf::Color::Green);//Set shape color to green.
     shape.setOrigin(size.x / 2, size.y / 2);//Set shape origin to center for demonstrating rotation.
 
+    //Shape state before the last update: drawing blends from it to the current state.
+    sf::Vector2<float> previous = shape.getPosition();
+    float previousRotation = shape.getRotation();
 
-    float timer = 0, //Timer variable for console printing every second. Prints Shape Position.
-          update = 0,//Timer var for updating
-          draw = 0,  //Timer var for drawing.
-          sleep = 0; //Timer var for sleeping.
+    float timer = 0; //Timer variable for console printing every second. Prints Shape Position.
 
     std::cout << std::fixed;//Set console output to be fixed and right aligned.
 
-    const float fps = 1 / 60.f, //Expected milliseconds per frame(draw).
-                tps = 1 / 120.f,//Expected milliseconds per frame(update).
-                sps = 1 / 240.f;//... per frame(action).
+    //Updates at 120 per second, draws at 60 per second.
+    //Replaces the update/draw/sleep timers: no time is lost when an update is late.
+    my::Scheduler scheduler(120.f, 60.f);
 
     size_t frames = 0;//Frames count per second.
 
+    //Records how long each phase of every frame takes; dumped to file on exit.
+    my::Profiler profiler;
+
+    //Keyboard state fed by key events.
+    my::InputState keyState;
+
     //Game Loop, runs while window is open.
     while (window.isOpen()) {
-        //Acuire delta time.
-        //Capture clock time in secons since last restart
-        float delta = clock.getElapsedTime().asSeconds();
-        clock.restart();//Restart clock 
+        //Acuire delta time and the number of fixed updates due.
+        profiler.beginFrame();
+        std::size_t steps = scheduler.advance();
 
-        timer += delta;//Accumulate delta time.
+        timer += scheduler.delta;//Accumulate delta time.
         if (timer > 1) {
             //Print to console position relative to shape.
             std::cout << std::right << std::setw(10) << std::setprecision(2) << shape.getPosition().x
@@ -77,72 +82,85 @@ int main() {
                       << std::right << std::setw(5) << frames << '\n';
             timer -= 1;//decrement timer by 1 second. Set to zero if no catchup.
             frames = 0;
+            profiler.print(std::cout);
         }
 
         //Declare an event variable.
         sf::Event event;
 
         //Poll event variables state.
+        my::Profiler::Clock::time_point polling = my::Profiler::Clock::now();
         while (window.pollEvent(event)) {
             //Enter loop if there are events occuring or still available.
 
             //Check if window is closed or if 'escape' key was pressed.
             if (event.type == sf::Event::Closed || 
-                sf::Keyboard::isKeyPressed(sf::Keyboard::Escape))
+                (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape))
                 window.close();
 
-            //Otherwise, iterate through our map and determine if buttons were pressed
-            //If buttons were pressed, set button state to true, else set button state of false.
-            for (auto pair : input) {
-                if (sf::Keyboard::isKeyPressed(pair.first))
-                    input[pair.first] = true;
-                else
-                    input[pair.first] = false;
-            }
+            //Otherwise, record key presses and releases: no keyboard queries per event.
+            keyState.handle(event);
+            if (event.type == sf::Event::LostFocus)
+                keyState.releaseAll();
         }
 
-        //Check if time to update:
-        update += delta;
-        if (update > tps) {
+        //Take this frame's snapshot, then iterate through our map and set each button state
+        //from it. The update step only reads this snapshot.
+        my::KeySnapshot keys = keyState.snapshot();
+        for (auto& pair : input)
+            pair.second = keys.isDown(pair.first);
+
+        profiler.add(my::Phase::Events, polling, my::Profiler::Clock::now());
+
+        //Run every update due, each with the same fixed step.
+        const float step = scheduler.getStep();
+        while (steps--) {
+            my::Profiler::Scope scope(profiler, my::Phase::Update);
+            previous = shape.getPosition();
+            previousRotation = shape.getRotation();
             //Evaluate button states
             for (auto pair : input)
                 if (pair.second)
                     switch (pair.first) {
                     case sf::Keyboard::Up:
-                        shape.move(0,-velocity.y * update);//move by a rate of vel mul delta
+                        shape.move(0,-velocity.y * step);//move by a rate of vel mul delta
                         break;
                     case sf::Keyboard::Down:
-                        shape.move(0, velocity.y * update);
+                        shape.move(0, velocity.y * step);
                         break;
                     case sf::Keyboard::Left:
-                        shape.move(-velocity.y * update, 0);
+                        shape.move(-velocity.y * step, 0);
                         break;
                     case sf::Keyboard::Right:
-                        shape.move( velocity.y * update, 0);
+                        shape.move( velocity.y * step, 0);
                         break;
                     case sf::Keyboard::Space:
-                        shape.rotate(10.f * update);
+                        shape.rotate(10.f * step);
                         break;
                     }
-            update -= tps;//Set to zero if no catchup.
         }
         
-        //Check if time to draw
-        draw += delta;
-        if (draw > fps) {
+        //Check if time to draw: draw between the last two updates.
+        if (scheduler.drawDue()) {
+            my::Profiler::Scope scope(profiler, my::Phase::Draw);
+            sf::RectangleShape drawn(shape);
+            drawn.setPosition(my::lerp(previous, shape.getPosition(), scheduler.getAlpha()));
+            float turn = shape.getRotation() - previousRotation;//Rotation wraps at 360.
+            drawn.setRotation(previousRotation + (turn < -180 ? turn + 360 : turn) * scheduler.getAlpha());
             window.clear();
-            window.draw(shape);
+            window.draw(drawn);
             window.display();
-            draw -= fps;//Set to zero if no catchup.
             ++frames;
         }
 
-        sleep += delta;
-        if (sleep > sps) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(2));
-            //sps is 1000/240 = ~4ms, this will sleep the thread for 2ms.
-            sleep -= sps;//Set to zero if no catchup.
+        //Sleep until the next update or draw is due.
+        {
+            my::Profiler::Scope scope(profiler, my::Phase::Sleep);
+            scheduler.wait();
         }
+        profiler.endFrame();
     }
+    profiler.writeCsv("profile.csv");
+    profiler.writeTrace("profile.json");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "aabbtree.hpp"
+#include <algorithm>
+
+const int my::AABBTree::null;
+
+sf::FloatRect my::AABBTree::combine(const sf::FloatRect& a, const sf::FloatRect& b) {
+    float left = std::min(a.left, b.left), top = std::min(a.top, b.top),
+          right = std::max(a.left + a.width, b.left + b.width),
+          bottom = std::max(a.top + a.height, b.top + b.height);
+    return sf::FloatRect{ left, top, right - left, bottom - top };
+}
+
+my::AABBTree::AABBTree(float margin) : root{ null }, freeList{ null }, leaves{ 0 }, margin{ margin } {}
+int my::AABBTree::allocate() {
+    if (freeList == null) {
+        nodes.push_back(Node{ sf::FloatRect{}, null, null, null, -1, 0 });
+        freeList = static_cast<int>(nodes.size()) - 1;
+    }
+    int node = freeList;
+    freeList = nodes[node].parent;
+    nodes[node] = Node{ sf::FloatRect{}, null, null, null, 0, 0 };
+    return node;
+}
+void my::AABBTree::release(int node) {
+    nodes[node].parent = freeList;
+    nodes[node].height = -1;
+    freeList = node;
+}
+int my::AABBTree::insert(const sf::FloatRect& box, std::size_t data) {
+    int leaf = allocate();
+    nodes[leaf].box = sf::FloatRect{ box.left - margin, box.top - margin, box.width + margin * 2, box.height + margin * 2 };
+    nodes[leaf].data = data;
+    insertLeaf(leaf);
+    ++leaves;
+    return leaf;
+}
+void my::AABBTree::remove(int proxy) {
+    removeLeaf(proxy);
+    release(proxy);
+    --leaves;
+}
+bool my::AABBTree::move(int proxy, const sf::FloatRect& box) {
+    if (contains(nodes[proxy].box, box))
+        return false;
+    removeLeaf(proxy);
+    nodes[proxy].box = sf::FloatRect{ box.left - margin, box.top - margin, box.width + margin * 2, box.height + margin * 2 };
+    insertLeaf(proxy);
+    return true;
+}
+void my::AABBTree::insertLeaf(int leaf) {
+    if (root == null) {
+        root = leaf;
+        nodes[root].parent = null;
+        return;
+    }
+    //Walk down towards the sibling whose pairing adds the least perimeter.
+    sf::FloatRect box = nodes[leaf].box;
+    int index = root;
+    while (nodes[index].left != null) {
+        const Node& node = nodes[index];
+        float area = perimeter(node.box), combined = perimeter(combine(node.box, box));
+        //Pairing here costs a new parent; going lower also grows this node.
+        float cost = 2 * combined, inheritance = 2 * (combined - area);
+        auto descend = [this, &box, inheritance](int child) {
+            const Node& c = nodes[child];
+            float grown = perimeter(combine(box, c.box));
+            return (c.left == null ? grown : grown - perimeter(c.box)) + inheritance;
+        };
+        float left = descend(node.left), right = descend(node.right);
+        if (cost < left && cost < right)
+            break;
+        index = left < right ? node.left : node.right;
+    }
+    int sibling = index, oldParent = nodes[sibling].parent, newParent = allocate();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].box = combine(box, nodes[sibling].box);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].left = sibling;
+    nodes[newParent].right = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+    if (oldParent == null)
+        root = newParent;
+    else if (nodes[oldParent].left == sibling)
+        nodes[oldParent].left = newParent;
+    else
+        nodes[oldParent].right = newParent;
+    refit(nodes[leaf].parent);
+}
+void my::AABBTree::removeLeaf(int leaf) {
+    if (leaf == root) {
+        root = null;
+        return;
+    }
+    int parent = nodes[leaf].parent, grandParent = nodes[parent].parent,
+        sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+    release(parent);
+    if (grandParent == null) {
+        root = sibling;
+        nodes[sibling].parent = null;
+        return;
+    }
+    //The sibling takes the parent's place.
+    if (nodes[grandParent].left == parent)
+        nodes[grandParent].left = sibling;
+    else
+        nodes[grandParent].right = sibling;
+    nodes[sibling].parent = grandParent;
+    refit(grandParent);
+}
+void my::AABBTree::refit(int index) {
+    while (index != null) {
+        index = balance(index);
+        Node& node = nodes[index];
+        node.height = 1 + std::max(nodes[node.left].height, nodes[node.right].height);
+        node.box = combine(nodes[node.left].box, nodes[node.right].box);
+        index = node.parent;
+    }
+}
+int my::AABBTree::balance(int a) {
+    Node& A = nodes[a];
+    if (A.left == null || A.height < 2)
+        return a;
+    int b = A.left, c = A.right;
+    Node& B = nodes[b];
+    Node& C = nodes[c];
+    int difference = C.height - B.height;
+    //Rotate the taller child up into a's place; a keeps the shorter grandchild.
+    auto rotate = [this, a, &A](int up, Node& Up, Node& Other, bool right) {
+        int f = Up.left, g = Up.right;
+        Up.left = a;
+        Up.parent = A.parent;
+        A.parent = up;
+        if (Up.parent == null)
+            root = up;
+        else if (nodes[Up.parent].left == a)
+            nodes[Up.parent].left = up;
+        else
+            nodes[Up.parent].right = up;
+        //Taller grandchild stays with up, the other moves under a.
+        int keep = nodes[f].height > nodes[g].height ? f : g,
+            give = keep == f ? g : f;
+        Up.right = keep;
+        if (right)
+            A.right = give;
+        else
+            A.left = give;
+        nodes[give].parent = a;
+        A.box = combine(Other.box, nodes[give].box);
+        Up.box = combine(A.box, nodes[keep].box);
+        A.height = 1 + std::max(Other.height, nodes[give].height);
+        Up.height = 1 + std::max(A.height, nodes[keep].height);
+        return up;
+    };
+    if (difference > 1)
+        return rotate(c, C, B, true);
+    if (difference < -1)
+        return rotate(b, B, C, false);
+    return a;
+}
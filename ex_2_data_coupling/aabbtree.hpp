@@ -0,0 +1,137 @@
+#ifndef AABBTREE_HPP
+#define AABBTREE_HPP
+/*
+    Description: Dynamic AABB tree broadphase. Each proxy is a leaf holding a box fattened
+        by a margin, so small moves stay inside it and cost nothing; only a proxy leaving its
+        fat box is removed and inserted again. Inserts pick the sibling that grows the tree's
+        total perimeter least and rotations keep it balanced, so queries visit O(log n) nodes.
+        Queries reuse one scratch stack: do not query again from inside a query callback.
+*/
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace my {
+    class AABBTree {
+    public:
+        static const int null = -1;
+    private:
+        struct Node {
+            sf::FloatRect box;  //Fat box for leaves, union of children otherwise.
+            int parent;         //Next free node while on the free list.
+            int left, right;    //null for leaves.
+            int height;         //0 for leaves, -1 while free.
+            std::size_t data;
+        };
+        std::vector<Node> nodes;
+        int root, freeList;
+        std::size_t leaves;
+        float margin;
+        mutable std::vector<int> stack;
+        int allocate();
+        void release(int node);
+        void insertLeaf(int leaf);
+        void removeLeaf(int leaf);
+        //Rotates the taller grandchild up when children differ in height by more than one.
+        int balance(int node);
+        void refit(int node);
+    public:
+        //Box helpers: touching boxes do not overlap.
+        static bool overlaps(const sf::FloatRect& a, const sf::FloatRect& b) {
+            return a.left < b.left + b.width && b.left < a.left + a.width &&
+                   a.top < b.top + b.height && b.top < a.top + a.height;
+        }
+        static bool contains(const sf::FloatRect& outer, const sf::FloatRect& inner) {
+            return outer.left <= inner.left && outer.top <= inner.top &&
+                   inner.left + inner.width <= outer.left + outer.width &&
+                   inner.top + inner.height <= outer.top + outer.height;
+        }
+        static bool contains(const sf::FloatRect& box, const sf::Vector2f& point) {
+            return box.left <= point.x && point.x <= box.left + box.width &&
+                   box.top <= point.y && point.y <= box.top + box.height;
+        }
+        static sf::FloatRect combine(const sf::FloatRect& a, const sf::FloatRect& b);
+        static float perimeter(const sf::FloatRect& box) {
+            return 2 * (box.width + box.height);
+        }
+
+        explicit AABBTree(float margin = 4.f);
+        //Returns the proxy of a new leaf for box, carrying data.
+        int insert(const sf::FloatRect& box, std::size_t data);
+        void remove(int proxy);
+        //True when box left the fat box and the proxy was inserted again.
+        bool move(int proxy, const sf::FloatRect& box);
+        const sf::FloatRect& getFatBox(int proxy) const {
+            return nodes[proxy].box;
+        }
+        std::size_t getData(int proxy) const {
+            return nodes[proxy].data;
+        }
+        std::size_t size() const {
+            return leaves;
+        }
+        int getHeight() const {
+            return root == null ? 0 : nodes[root].height;
+        }
+
+        //Calls f(proxy) for every leaf whose fat box overlaps box; stops when f returns false.
+        template<class F>
+        void query(const sf::FloatRect& box, F f) const {
+            if (root == null)
+                return;
+            stack.clear();
+            stack.push_back(root);
+            while (!stack.empty()) {
+                int index = stack.back();
+                stack.pop_back();
+                const Node& node = nodes[index];
+                if (!overlaps(node.box, box))
+                    continue;
+                if (node.left == null) {
+                    if (!f(index))
+                        return;
+                    continue;
+                }
+                stack.push_back(node.left);
+                stack.push_back(node.right);
+            }
+        }
+        //Calls f(proxy) for every leaf whose fat box holds point; stops when f returns false.
+        template<class F>
+        void query(const sf::Vector2f& point, F f) const {
+            if (root == null)
+                return;
+            stack.clear();
+            stack.push_back(root);
+            while (!stack.empty()) {
+                int index = stack.back();
+                stack.pop_back();
+                const Node& node = nodes[index];
+                if (!contains(node.box, point))
+                    continue;
+                if (node.left == null) {
+                    if (!f(index))
+                        return;
+                    continue;
+                }
+                stack.push_back(node.left);
+                stack.push_back(node.right);
+            }
+        }
+        //Calls f(a, b) once for every pair of leaves whose fat boxes overlap, a < b.
+        template<class F>
+        void pairs(F f) const {
+            for (int i = 0; i < static_cast<int>(nodes.size()); ++i) {
+                if (nodes[i].height != 0)
+                    continue;
+                query(nodes[i].box, [&f, i](int other) {
+                    if (other > i)
+                        f(i, other);
+                    return true;
+                });
+            }
+        }
+    };
+}
+#endif // !AABBTREE_HPP
@@ -0,0 +1,134 @@
+#include "collisionworld.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    float dot(const sf::Vector2f& a, const sf::Vector2f& b) {
+        return a.x * b.x + a.y * b.y;
+    }
+    sf::Vector2f perpendicular(const sf::Vector2f& v) {
+        return sf::Vector2f{ -v.y, v.x };
+    }
+    //Half the rectangle's extent projected on axis.
+    float project(const my::Collider& rect, const sf::Vector2f& axis) {
+        return rect.half.x * std::abs(dot(rect.axis, axis)) + rect.half.y * std::abs(dot(perpendicular(rect.axis), axis));
+    }
+    bool rectangles(const my::Collider& a, const my::Collider& b) {
+        sf::Vector2f d = b.center - a.center;
+        const sf::Vector2f axes[] = { a.axis, perpendicular(a.axis), b.axis, perpendicular(b.axis) };
+        for (const auto& axis : axes)
+            if (std::abs(dot(d, axis)) >= project(a, axis) + project(b, axis))
+                return false;
+        return true;
+    }
+    bool circles(const my::Collider& a, const my::Collider& b) {
+        sf::Vector2f d = b.center - a.center;
+        float r = a.radius + b.radius;
+        return dot(d, d) < r * r;
+    }
+    //Closest point of the rectangle to the circle center, in the rectangle's frame.
+    bool rectangleCircle(const my::Collider& rect, const my::Collider& circle) {
+        sf::Vector2f d = circle.center - rect.center;
+        sf::Vector2f local{ dot(d, rect.axis), dot(d, perpendicular(rect.axis)) };
+        sf::Vector2f closest{ std::max(-rect.half.x, std::min(local.x, rect.half.x)),
+                              std::max(-rect.half.y, std::min(local.y, rect.half.y)) };
+        sf::Vector2f gap = local - closest;
+        return dot(gap, gap) < circle.radius * circle.radius;
+    }
+}
+
+my::Collider my::Collider::rectangle(const sf::Vector2f& center, const sf::Vector2f& size, float degrees) {
+    float radians = degrees * 3.14159265f / 180.f;
+    return Collider{ Rectangle, center, size / 2.f, { std::cos(radians), std::sin(radians) }, 0.f };
+}
+my::Collider my::Collider::circle(const sf::Vector2f& center, float radius) {
+    return Collider{ Circle, center, { radius, radius }, { 1.f, 0.f }, radius };
+}
+sf::FloatRect my::Collider::getBounds() const {
+    if (type == Circle)
+        return sf::FloatRect{ center.x - radius, center.y - radius, radius * 2, radius * 2 };
+    float x = half.x * std::abs(axis.x) + half.y * std::abs(axis.y),
+          y = half.x * std::abs(axis.y) + half.y * std::abs(axis.x);
+    return sf::FloatRect{ center.x - x, center.y - y, x * 2, y * 2 };
+}
+bool my::Collider::contains(const sf::Vector2f& point) const {
+    sf::Vector2f d = point - center;
+    if (type == Circle)
+        return dot(d, d) <= radius * radius;
+    return std::abs(dot(d, axis)) <= half.x && std::abs(dot(d, perpendicular(axis))) <= half.y;
+}
+bool my::overlaps(const Collider& a, const Collider& b) {
+    if (a.type == Collider::Rectangle)
+        return b.type == Collider::Rectangle ? rectangles(a, b) : rectangleCircle(a, b);
+    return b.type == Collider::Rectangle ? rectangleCircle(b, a) : circles(a, b);
+}
+
+my::CollisionWorld::CollisionWorld(float margin) : tree{ margin }, candidates{ 0 }, reinserted{ 0 } {}
+std::size_t my::CollisionWorld::add(const Collider& collider) {
+    std::size_t id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+        colliders[id] = collider;
+    }
+    else {
+        id = colliders.size();
+        colliders.push_back(collider);
+        proxies.push_back(AABBTree::null);
+    }
+    proxies[id] = tree.insert(collider.getBounds(), id);
+    return id;
+}
+void my::CollisionWorld::update(std::size_t id, const Collider& collider) {
+    colliders[id] = collider;
+    if (tree.move(proxies[id], collider.getBounds()))
+        ++reinserted;
+}
+void my::CollisionWorld::remove(std::size_t id) {
+    if (proxies[id] == AABBTree::null)
+        return;
+    tree.remove(proxies[id]);
+    proxies[id] = AABBTree::null;
+    freeIds.push_back(id);
+}
+const my::Collider& my::CollisionWorld::get(std::size_t id) const {
+    return colliders[id];
+}
+const my::AABBTree& my::CollisionWorld::getTree() const {
+    return tree;
+}
+void my::CollisionWorld::overlaps(std::vector<Pair>& out) {
+    out.clear();
+    candidates = 0;
+    tree.pairs([this, &out](int a, int b) {
+        std::size_t first = tree.getData(a), second = tree.getData(b);
+        ++candidates;
+        if (my::overlaps(colliders[first], colliders[second]))
+            out.push_back(first < second ? Pair{ first, second } : Pair{ second, first });
+    });
+    reinserted = 0;
+}
+void my::CollisionWorld::query(const sf::Vector2f& point, std::vector<std::size_t>& out) {
+    out.clear();
+    candidates = 0;
+    tree.query(point, [this, &point, &out](int proxy) {
+        std::size_t id = tree.getData(proxy);
+        ++candidates;
+        if (colliders[id].contains(point))
+            out.push_back(id);
+        return true;
+    });
+}
+void my::CollisionWorld::query(const sf::FloatRect& region, std::vector<std::size_t>& out) {
+    out.clear();
+    candidates = 0;
+    Collider box = Collider::rectangle({ region.left + region.width / 2, region.top + region.height / 2 },
+                                       { region.width, region.height }, 0.f);
+    tree.query(region, [this, &box, &out](int proxy) {
+        std::size_t id = tree.getData(proxy);
+        ++candidates;
+        if (my::overlaps(box, colliders[id]))
+            out.push_back(id);
+        return true;
+    });
+}
@@ -0,0 +1,61 @@
+#ifndef COLLISIONWORLD_HPP
+#define COLLISIONWORLD_HPP
+/*
+    Description: Collision queries over mixed rectangles and circles. Colliders live in a
+        dynamic AABB tree; candidates from the tree are confirmed with exact shape tests
+        (rotated rectangles by separating axes, circles by distance), never by boxes alone.
+*/
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "aabbtree.hpp"
+
+namespace my {
+    //Exact shape of a collider in world space.
+    struct Collider {
+        enum Type {
+            Rectangle,
+            Circle
+        };
+        Type type;
+        sf::Vector2f center;
+        sf::Vector2f half;  //Rectangle half extents along its own axes.
+        sf::Vector2f axis;  //Rectangle unit x axis: (cos, sin) of its rotation.
+        float radius;       //Circle
+        static Collider rectangle(const sf::Vector2f& center, const sf::Vector2f& size, float degrees);
+        static Collider circle(const sf::Vector2f& center, float radius);
+        sf::FloatRect getBounds() const;
+        bool contains(const sf::Vector2f& point) const;
+    };
+    bool overlaps(const Collider& a, const Collider& b);
+
+    class CollisionWorld {
+    private:
+        AABBTree tree;
+        std::vector<Collider> colliders;
+        std::vector<int> proxies;           //Tree proxy per id, AABBTree::null once removed.
+        std::vector<std::size_t> freeIds;
+    public:
+        typedef std::pair<std::size_t, std::size_t> Pair;
+        //Tree candidates tested exactly by the last query, proxies re-inserted by update since the last overlaps.
+        std::size_t candidates, reinserted;
+        //margin: how far a collider moves before its tree entry is rebuilt.
+        explicit CollisionWorld(float margin = 4.f);
+        //Returns the collider's id, stable until removed.
+        std::size_t add(const Collider& collider);
+        void update(std::size_t id, const Collider& collider);
+        void remove(std::size_t id);
+        const Collider& get(std::size_t id) const;
+        const AABBTree& getTree() const;
+
+        //Every overlapping pair once, lower id first.
+        void overlaps(std::vector<Pair>& out);
+        //Colliders holding point.
+        void query(const sf::Vector2f& point, std::vector<std::size_t>& out);
+        //Colliders overlapping region.
+        void query(const sf::FloatRect& region, std::vector<std::size_t>& out);
+    };
+}
+#endif // !COLLISIONWORLD_HPP
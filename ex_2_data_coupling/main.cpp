@@ -7,22 +7,90 @@
 #include <SFML/Graphics.hpp>
 #include <iostream>
 #include <vector>
+#include <memory>
 #include <iomanip>
 #include <thread>       //Sleep to save processing time.
 #include <unordered_map>//Unordered map: holds a key pair that can be accessed with 
 //first and second variable names. This object is being used
 //to map our input state with preset SFML enumerators.
 #include <utility>//For pair: to couple our timer data
-#include <memory>
 #include <random>
+#include <cmath>
+#include <string>
+#include "../common/scheduler.hpp"//Fixed timestep loop: update catch-up, draw pacing, sleeping.
+#include "../common/profiler.hpp" //Per phase frame timings: events, update, draw, sleep.
+#include "../common/input.hpp"    //Key state built from events, read once per frame.
+#include "../common/camera.hpp"      //View that follows the player; culls through the collision tree.
+#include "../common/kinematic.hpp"   //Velocity and cached world bounds for moving shapes.
+#include "collisionworld.hpp"         //AABB tree broadphase with exact shape tests.
+#include "pool.hpp"                   //Contiguous per-type storage with generational handles.
 
 namespace my {
-    //Extending the Rectangle Shape class from SFML
-    class RectangleShape : public sf::RectangleShape {
+    //Extending the Rectangle Shape class from SFML, with a velocity and cached world bounds.
+    //Final: calls on the concrete type need no virtual dispatch.
+    class RectangleShape final : public Kinematic<sf::RectangleShape> {
+    public:
+        std::size_t collider;//Id in the collision world.
+        RectangleShape(sf::Vector2<float>& size): Kinematic<sf::RectangleShape>(size), collider{ 0 } {}
+        //Exact world shape for collision queries: center, scaled size and rotation.
+        Collider getCollider() const {
+            return Collider::rectangle(getTransform().transformPoint(getSize() / 2.f),
+                { getSize().x * getScale().x, getSize().y * getScale().y }, getRotation());
+        }
+        //Two triangles of the filled rectangle in world space, for drawing every shape in one call.
+        void append(sf::VertexArray& triangles) const {
+            const sf::Transform& transform = getTransform();
+            sf::Vector2<float> size = getSize();
+            const sf::Vector2<float> corners[4] = { transform.transformPoint({ 0, 0 }), transform.transformPoint({ size.x, 0 }),
+                                                    transform.transformPoint(size), transform.transformPoint({ 0, size.y }) };
+            for (int i : { 0, 1, 2, 0, 2, 3 })
+                triangles.append(sf::Vertex{ corners[i], getFillColor() });
+        }
+    };
+    class CircleShape final : public Kinematic<sf::CircleShape> {
+    public:
+        std::size_t collider;//Id in the collision world.
+        CircleShape(float radius = 0, std::size_t pointCount = 30): Kinematic<sf::CircleShape>(radius,pointCount), collider{ 0 } {}
+        Collider getCollider() const {
+            return Collider::circle(getTransform().transformPoint({ getRadius(), getRadius() }), getRadius() * getScale().x);
+        }
+        //Triangles fanned from the first point, same points as SFML's but from a unit circle
+        //computed once instead of trigonometry per point per frame.
+        void append(sf::VertexArray& triangles) const {
+            static std::vector<sf::Vector2<float>> unit;
+            std::size_t count = getPointCount();
+            if (unit.size() != count) {
+                unit.resize(count);
+                for (std::size_t i = 0; i < count; ++i) {
+                    float angle = i * 2 * 3.141592654f / count - 3.141592654f / 2;
+                    unit[i] = { std::cos(angle), std::sin(angle) };
+                }
+            }
+            const sf::Transform& transform = getTransform();
+            float r = getRadius();
+            auto point = [&transform, r](const sf::Vector2<float>& p) {
+                return transform.transformPoint({ r + p.x * r, r + p.y * r });
+            };
+            sf::Vector2<float> first = point(unit[0]), last = point(unit[1]);
+            for (std::size_t i = 2; i < count; ++i) {
+                sf::Vector2<float> next = point(unit[i]);
+                triangles.append(sf::Vertex{ first, getFillColor() });
+                triangles.append(sf::Vertex{ last, getFillColor() });
+                triangles.append(sf::Vertex{ next, getFillColor() });
+                last = next;
+            }
+        }
+    };
+}
+
+namespace legacy {
+    //The shape classes as they were before my::Kinematic, kept for the benchmark: each
+    //repeats the velocity and forwards SFML's point functions, one heap allocation per shape.
+    class RectangleShape : public my::CachedBounds<sf::RectangleShape> {
     private:
         sf::Vector2<float> velocity;
     public:
-        RectangleShape(sf::Vector2<float>& size): sf::RectangleShape(size){}
+        RectangleShape(sf::Vector2<float>& size): my::CachedBounds<sf::RectangleShape>(size){}
         void setVelocity(float x, float y) {
             this->velocity.x = x;
             this->velocity.y = y;
@@ -34,8 +102,6 @@ namespace my {
         const sf::Vector2<float>& getVelocity() const {
             return velocity;
         }
-
-        //Required overrides from pure virtual functions from Rectanlge Shape
         std::size_t getPointCount() const override {
             return sf::RectangleShape::getPointCount();
         }
@@ -43,11 +109,11 @@ namespace my {
             return sf::RectangleShape::getPoint(index);
         }
     };
-    class CircleShape : public sf::CircleShape {
+    class CircleShape : public my::CachedBounds<sf::CircleShape> {
     private:
         sf::Vector2<float> velocity;
     public:
-        CircleShape(float radius = 0, std::size_t pointCount = 30): sf::CircleShape(radius,pointCount){}
+        CircleShape(float radius = 0, std::size_t pointCount = 30): my::CachedBounds<sf::CircleShape>(radius,pointCount){}
         void setVelocity(float x, float y) {
             this->velocity.x = x;
             this->velocity.y = y;
@@ -59,8 +125,6 @@ namespace my {
         const sf::Vector2<float>& getVelocity() const {
             return velocity;
         }
-
-        //Required overrides from pure virtual functions from Rectanlge Shape
         std::size_t getPointCount() const override {
             return sf::CircleShape::getPointCount();
         }
@@ -69,7 +133,78 @@ namespace my {
         }
     };
 }
-int main() {
+
+//Times the update+bounds pass of ticks updates over count shapes, half of each kind:
+//legacy classes behind shared_ptr against Kinematic shapes in pools.
+int benchShapes(std::size_t count, std::size_t ticks) {
+    std::mt19937 rand{ 0 };
+    std::uniform_real_distribution<float> coordinate{ 0, 500 }, heading{ -100.f, 100.f };
+    sf::Vector2<float> small{ 10,10 };
+    std::vector<std::shared_ptr<legacy::RectangleShape>> oldRectangles;
+    std::vector<std::shared_ptr<legacy::CircleShape>> oldCircles;
+    my::Pool<my::RectangleShape> rectangles;
+    my::Pool<my::CircleShape> circles;
+    rectangles.reserve(count / 2 + 1);
+    circles.reserve(count / 2 + 1);
+    for (std::size_t i = 0; i < count; ++i) {
+        sf::Vector2<float> position{ coordinate(rand), coordinate(rand) }, velocity{ heading(rand), heading(rand) };
+        if (i % 2) {
+            oldCircles.push_back(std::make_shared<legacy::CircleShape>(small.x / 2));
+            oldCircles.back()->setPosition(position);
+            oldCircles.back()->setVelocity(velocity);
+            my::CircleShape& circle = *circles.get(circles.create(small.x / 2));
+            circle.setPosition(position);
+            circle.setVelocity(velocity);
+        }
+        else {
+            oldRectangles.push_back(std::make_shared<legacy::RectangleShape>(small));
+            oldRectangles.back()->setPosition(position);
+            oldRectangles.back()->setVelocity(velocity);
+            my::RectangleShape& rectangle = *rectangles.get(rectangles.create(small));
+            rectangle.setPosition(position);
+            rectangle.setVelocity(velocity);
+        }
+    }
+    float delta = 1 / 120.f, sum = 0;//Sum of bounds keeps the work from being optimized away.
+
+    sf::Clock clock;
+    for (std::size_t tick = 0; tick < ticks; ++tick) {
+        for (auto& rectangle : oldRectangles) {
+            rectangle->move(rectangle->getVelocity() * delta);
+            sum += rectangle->getGlobalBounds().left;
+        }
+        for (auto& circle : oldCircles) {
+            circle->move(circle->getVelocity() * delta);
+            sum += circle->getGlobalBounds().left;
+        }
+    }
+    double old = clock.restart().asSeconds();
+    for (std::size_t tick = 0; tick < ticks; ++tick) {
+        my::step(rectangles, delta);
+        my::step(circles, delta);
+        for (const auto& rectangle : rectangles)
+            sum += rectangle.getGlobalBounds().left;
+        for (const auto& circle : circles)
+            sum += circle.getGlobalBounds().left;
+    }
+    double kinematic = clock.getElapsedTime().asSeconds();
+
+    auto perShape = [count, ticks](double seconds) {
+        return count && ticks ? seconds * 1e9 / (count * ticks) : 0;
+    };
+    std::cout << count << " shapes, " << ticks << " ticks (checksum " << sum << ")\n"
+              << "legacy:    " << old << " s, " << perShape(old) << " ns/shape\n"
+              << "kinematic: " << kinematic << " s, " << perShape(kinematic) << " ns/shape, "
+              << (kinematic > 0 ? old / kinematic : 0) << "x\n";
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    //Shape update benchmark: data_coupling --bench-shapes [count] [ticks]
+    if (argc > 1 && std::string{ argv[1] } == "--bench-shapes")
+        return benchShapes(argc > 2 ? std::stoul(argv[2]) : 100000, argc > 3 ? std::stoul(argv[3]) : 600);
+    //Stress: data_coupling --shapes [count] adds count small drifting shapes, half of each kind.
+    std::size_t crowd = argc > 1 && std::string{ argv[1] } == "--shapes" ? (argc > 2 ? std::stoul(argv[2]) : 2000) : 0;
 
     //Random seed based on current time since epoch.
     unsigned seed = static_cast<unsigned>(std::chrono::system_clock::now().time_since_epoch().count());
@@ -87,63 +222,105 @@ int main() {
     //Declare the Window and set the video mode and title.
     sf::RenderWindow window(vmode, "SFML works!");
 
-    //Create a clock to acquire delta time per cycle of loop.
-    sf::Clock clock;
+    sf::Vector2<float> size{ 50,50 }, velocity{ 100,100 }, small{ 10,10 };
 
-    sf::Vector2<float> size{ 50,50 }, velocity{ 100,100 };
+    //Each kind of shape in its own pool: contiguous, one allocation for all of them.
+    my::Pool<my::RectangleShape> rectangles;
+    my::Pool<my::CircleShape> circles;
+    rectangles.reserve(3 + crowd);
+    circles.reserve(3 + crowd);
 
-    //Container for each type of our rectangle shapes: Smart pointers
-    std::vector<std::shared_ptr<my::RectangleShape>> rectangles{
-        std::make_shared<my::RectangleShape>(size),
-        std::make_shared<my::RectangleShape>(size),
-        std::make_shared<my::RectangleShape>(size)
+    //Every shape has a collider, kept in step with it each update.
+    my::CollisionWorld collisions;
+    //Shape owning each collider id, for turning the tree's answers back into shapes.
+    //A null handle means the collider belongs to the other kind.
+    std::vector<my::Pool<my::RectangleShape>::Handle> rectangleOf;
+    std::vector<my::Pool<my::CircleShape>::Handle> circleOf;
+    auto own = [&rectangleOf, &circleOf](std::size_t collider, my::Pool<my::RectangleShape>::Handle rectangle,
+                                         my::Pool<my::CircleShape>::Handle circle) {
+        if (collider >= rectangleOf.size()) {
+            rectangleOf.resize(collider + 1);
+            circleOf.resize(collider + 1);
+        }
+        rectangleOf[collider] = rectangle;
+        circleOf[collider] = circle;
     };
 
-    //Container for each type of our circle shapes: Smart pointers
-    std::vector<std::shared_ptr<my::CircleShape>> circles{
-        std::make_shared<my::CircleShape>(size.x/2),
-        std::make_shared<my::CircleShape>(size.x/2),
-        std::make_shared<my::CircleShape>(size.x/2)
+    //Enemies: Red Rectangles, placed inside the window.
+    auto spawnRectangle = [&](sf::Vector2<float> size, sf::Vector2<float> velocity) {
+        my::Pool<my::RectangleShape>::Handle handle = rectangles.create(size);
+        my::RectangleShape& rectangle = *rectangles.get(handle);
+        rectangle.setVelocity(velocity);
+        rectangle.setFillColor(sf::Color::Red);
+        float x = rectangle.getSize().x / 2,
+              y = rectangle.getSize().y / 2;
+        rectangle.setOrigin(x,y);
+        rectangle.setPosition(rand() % (vmode.width - (int)x * 2) + x,
+            rand() % (vmode.height - (int)y * 2) + y);
+        rectangle.collider = collisions.add(rectangle.getCollider());
+        own(rectangle.collider, handle, {});
+        return handle;
+    };
+    //Neutrals: Yellow Circles
+    auto spawnCircle = [&](float radius, sf::Vector2<float> velocity) {
+        my::Pool<my::CircleShape>::Handle handle = circles.create(radius);
+        my::CircleShape& circle = *circles.get(handle);
+        circle.setVelocity(velocity);
+        circle.setFillColor(sf::Color::Yellow);
+        float r = circle.getRadius();
+        circle.setOrigin(r, r);
+        circle.setPosition((rand() % (vmode.width - (int)r * 2)) + r,
+            (rand() % (vmode.height - (int)r * 2)) + r);
+        circle.collider = collisions.add(circle.getCollider());
+        own(circle.collider, {}, handle);
+        return handle;
     };
 
-    //Container for all of our shapes to be drawn in our program.
-    std::vector<std::shared_ptr<sf::Shape>> shapes;
-    shapes.reserve(20);//Reserve up to 50 units; more than enough space.
-
-    //Add the all of the shapes to our universal container.
-    shapes.insert(shapes.begin(), rectangles.begin(), rectangles.end());
-    shapes.insert(shapes.begin() + rectangles.size(), circles.begin(), circles.end());
-
-    //Initialize Enemies: Red Rectangles
-    for (auto rectangle : rectangles) {
-        rectangle->setVelocity(velocity);
-        rectangle->setFillColor(sf::Color::Red);
-        float x = rectangle->getSize().x / 2, 
-              y = rectangle->getSize().y / 2;
-        rectangle->setOrigin(x,y);
-        rectangle->setPosition(rand() % (vmode.width - (int)x * 2) + x, 
-            rand() % (vmode.height - (int)y * 2) + y);
-    }
+    //Initialize Enemies
+    for (int i = 0; i < 3; ++i)
+        spawnRectangle(size, velocity);
 
-    //Initialize Player: One green Rectangle
-    auto player(rectangles[0]);
-    player->setFillColor(sf::Color::Green);
-
-    //Initialize Neutrals: Yellow Circles
-    for (auto circle : circles) {
-        circle->setVelocity(velocity);
-        circle->setFillColor(sf::Color::Yellow);
-        float r = circle->getRadius();
-        circle->setOrigin(r, r);
-        circle->setPosition((rand() % (vmode.width - (int)r * 2)) + r, 
-            (rand() % (vmode.height - (int)r * 2)) + r);
-    }
+    //Initialize Player: One green Rectangle. Pools move objects around: hold the handle.
+    my::Pool<my::RectangleShape>::Handle playerHandle = rectangles.handle(0);
+    rectangles.get(playerHandle)->setFillColor(sf::Color::Green);
+
+    //Initialize Neutrals
+    for (int i = 0; i < 3; ++i)
+        spawnCircle(size.x / 2, velocity);
+
+    //Crowd: small shapes heading off in random directions, half of each kind.
+    std::uniform_real_distribution<float> heading{ -100.f, 100.f };
+    auto spawnCrowd = [&](std::size_t i) {
+        if (i % 2)
+            spawnCircle(small.x / 2, { heading(rand), heading(rand) });
+        else
+            spawnRectangle(small, { heading(rand), heading(rand) });
+    };
+    for (std::size_t i = 0; i < crowd; ++i)
+        spawnCrowd(i);
+    //Shapes replaced every update in stress mode: the whole crowd once a second.
+    std::size_t churn = crowd / 120, spawned = 0;
+
+    std::vector<std::size_t> hits;
+    std::vector<my::CollisionWorld::Pair> contacts;
+    //Contacts found over this second, and those touching the player.
+    std::size_t contactCount = 0, playerContacts = 0;
 
-    //Initialize our timers for occurance of printing, updating, drawing, and sleeping.
+    //Every visible shape in one triangle list: one draw call, no virtual draw per shape.
+    sf::VertexArray triangles{ sf::Triangles };
+    //Follows the player; the mouse wheel zooms. Only colliders in its bounds are drawn.
+    my::Camera camera{ { 0, 0, static_cast<float>(vmode.width), static_cast<float>(vmode.height) } };
+    std::vector<std::size_t> visible;
+
+    //Initialize our timer for occurance of printing.
     //Argument is a float value representing milliseconds per second.
-    std::pair<float, float> print{ 0.f, 1.f },
-                            update{ 0.f, 1 / 120.f },
-                            draw{ 0.f, 1 / 60.f };
+    std::pair<float, float> print{ 0.f, 1.f };
+
+    //Updates at 120 per second, draws at 60 per second, sleeps until either is due.
+    my::Scheduler scheduler{ 120.f, 60.f };
+
+    //Player position before the last update: drawing blends from it to the current one.
+    sf::Vector2<float> previous = rectangles.get(playerHandle)->getPosition();
 
     //Set console output to be fixed and right aligned.
     std::cout << std::fixed;
@@ -151,88 +328,179 @@ int main() {
     //Frame counter per second.
     size_t frames = 0;
 
+    //Records how long each phase of every frame takes; dumped to file on exit.
+    my::Profiler profiler;
+
+    //Keyboard state fed by key events.
+    my::InputState keyState;
+
     //Game Loop, runs while window is open.
     while (window.isOpen()) {
-        //Acuire delta time.
-        //Capture clock time in secons since last restart
-        float delta = clock.getElapsedTime().asSeconds();
-        clock.restart();//Restart clock 
+        //Acuire delta time and the number of fixed updates due.
+        profiler.beginFrame();
+        std::size_t steps = scheduler.advance();
 
-        print.first += delta;//Accumulate delta time.
-        if (print.first > update.second) {
+        print.first += scheduler.delta;//Accumulate delta time.
+        if (print.first > print.second) {
+            const my::RectangleShape* player = rectangles.get(playerHandle);
             //Print to console position relative to shape.
             std::cout << std::right << std::setw(10) << std::setprecision(2) << player->getPosition().x
                 << std::right << std::setw(10) << player->getPosition().y
                 << std::right << std::setw(5) << frames << '\n';
             print.first -= print.second;//decrement timer by 1 second. Set to zero if no catchup.
             frames = 0;
-            for (auto shape : shapes)
-                if (player->getGlobalBounds().intersects(shape->getGlobalBounds()) && player != shape) {
-                    std::cout << "Collide\n";
-                }
+            profiler.print(std::cout);
+            //Collisions are checked every update; this only reports them.
+            std::cout << contactCount << " contacts (" << playerContacts << " with player) over "
+                      << collisions.getTree().size() << " shapes, tree height " << collisions.getTree().getHeight()
+                      << ", " << spawned << " respawned, "
+                      << camera.visible << '/' << camera.total << " visible\n";
+            contactCount = 0;
+            playerContacts = 0;
+            spawned = 0;
         }
 
         //Declare an event variable.
         sf::Event event;
 
         //Poll event variables state.
+        my::Profiler::Clock::time_point polling = my::Profiler::Clock::now();
         while (window.pollEvent(event)) {
             //Enter loop if there are events occuring or still available.
 
             //Check if window is closed or if 'escape' key was pressed.
             if (event.type == sf::Event::Closed ||
-                sf::Keyboard::isKeyPressed(sf::Keyboard::Escape))
+                (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape))
                 window.close();
 
-            //Otherwise, iterate through our map and determine if buttons were pressed
-            //If buttons were pressed, set button state to true, else set button state of false.
-            for (auto pair : input) {
-                if (sf::Keyboard::isKeyPressed(pair.first))
-                    input[pair.first] = true;
-                else
-                    input[pair.first] = false;
+            //Otherwise, record key presses and releases: no keyboard queries per event.
+            keyState.handle(event);
+            if (event.type == sf::Event::LostFocus)
+                keyState.releaseAll();
+
+            //Point query: report the shapes under a click.
+            if (event.type == sf::Event::MouseButtonPressed) {
+                collisions.query(window.mapPixelToCoords({ event.mouseButton.x, event.mouseButton.y }), hits);
+                std::cout << hits.size() << " shapes under cursor\n";
             }
+            if (event.type == sf::Event::MouseWheelScrolled)
+                camera.zoom(event.mouseWheelScroll.delta > 0 ? 0.9f : 1.1f);
         }
 
-        //Check if time to update:
-        update.first += delta;
-        if (update.first > update.second) {
+        //Take this frame's snapshot, then iterate through our map and set each button state
+        //from it. The update step only reads this snapshot.
+        my::KeySnapshot keys = keyState.snapshot();
+        for (auto& pair : input)
+            pair.second = keys.isDown(pair.first);
+
+        profiler.add(my::Phase::Events, polling, my::Profiler::Clock::now());
+
+        //Run every update due, each with the same fixed step.
+        const float step = scheduler.getStep();
+        while (steps--) {
+            my::Profiler::Scope scope(profiler, my::Phase::Update);
+            //Stress mode: despawn random shapes (never the player) and spawn as many new ones.
+            for (std::size_t i = 0; i < churn; ++i) {
+                if (i % 2 && circles.size()) {
+                    std::size_t at = rand() % circles.size();
+                    collisions.remove(circles[at].collider);
+                    circles.destroy(circles.handle(at));
+                }
+                else if (rectangles.size() > 1) {
+                    std::size_t at = rand() % rectangles.size();
+                    if (rectangles.handle(at) == playerHandle)
+                        at = (at + 1) % rectangles.size();
+                    collisions.remove(rectangles[at].collider);
+                    rectangles.destroy(rectangles.handle(at));
+                }
+                spawnCrowd(i);
+                ++spawned;
+            }
+            my::RectangleShape* player = rectangles.get(playerHandle);
+            previous = player->getPosition();
             //Evaluate button states
             for (auto pair : input)
                 if (pair.second) {
                     switch (pair.first) {
                     case sf::Keyboard::Up:
-                        player->move(0, -player->getVelocity().y * update.first);//move by a rate of vel mul delta
+                        player->move(0, -player->getVelocity().y * step);//move by a rate of vel mul delta
                         break;
                     case sf::Keyboard::Down:
-                        player->move(0, player->getVelocity().y * update.first);
+                        player->move(0, player->getVelocity().y * step);
                         break;
                     case sf::Keyboard::Left:
-                        player->move(-player->getVelocity().y * update.first, 0);
+                        player->move(-player->getVelocity().y * step, 0);
                         break;
                     case sf::Keyboard::Right:
-                        player->move(player->getVelocity().y * update.first, 0);
+                        player->move(player->getVelocity().y * step, 0);
                         break;
                     case sf::Keyboard::Space:
-                        player->rotate(100.f * update.first);
+                        player->rotate(100.f * step);
                         break;
                     }
                 }
-            update.first -= update.second;//Set to zero if no catchup.
+            //In stress mode everything but the player drifts and bounces off the window edges.
+            auto drift = [&vmode, step](auto& shape) {
+                shape.step(step);
+                sf::Vector2<float> position = shape.getPosition();
+                if (position.x < 0 || position.x > vmode.width)
+                    shape.velocity.x = -shape.velocity.x;
+                if (position.y < 0 || position.y > vmode.height)
+                    shape.velocity.y = -shape.velocity.y;
+            };
+            if (crowd) {
+                for (auto& rectangle : rectangles)
+                    if (&rectangle != player)
+                        drift(rectangle);
+                for (auto& circle : circles)
+                    drift(circle);
+            }
+            //Collide everything, every tick: the tree only rebuilds entries that left their margin.
+            for (const auto& rectangle : rectangles)
+                collisions.update(rectangle.collider, rectangle.getCollider());
+            for (const auto& circle : circles)
+                collisions.update(circle.collider, circle.getCollider());
+            collisions.overlaps(contacts);
+            contactCount += contacts.size();
+            for (const auto& contact : contacts)
+                if (contact.first == player->collider || contact.second == player->collider)
+                    ++playerContacts;
         }
 
-        //Check if time to draw
-        draw.first += delta;
-        if (draw.first > draw.second) {
+        //Check if time to draw: the player is drawn between its last two positions.
+        if (scheduler.drawDue()) {
+            my::Profiler::Scope scope(profiler, my::Phase::Draw);
+            my::RectangleShape* player = rectangles.get(playerHandle);
+            sf::Vector2<float> current = player->getPosition();
+            player->setPosition(my::lerp(previous, current, scheduler.getAlpha()));
+            camera.follow(player->getPosition());
+            //Cull: the tree answers with the colliders in view, not every shape.
+            collisions.query(camera.getBounds(), visible);
+            camera.count(visible.size(), rectangles.size() + circles.size());
+            triangles.clear();
+            //Rectangles first, circles over them.
+            for (std::size_t id : visible)
+                if (const my::RectangleShape* rectangle = rectangles.get(rectangleOf[id]))
+                    rectangle->append(triangles);
+            for (std::size_t id : visible)
+                if (const my::CircleShape* circle = circles.get(circleOf[id]))
+                    circle->append(triangles);
+            camera.apply(window);
             window.clear();
-            for(auto &shape: shapes)
-                window.draw(*shape.get());
+            window.draw(triangles);
             window.display();
-            draw.first -= draw.second;//Set to zero if no catchup.
+            player->setPosition(current);
             ++frames;
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000/240));
+        //Sleep until the next update or draw is due.
+        {
+            my::Profiler::Scope scope(profiler, my::Phase::Sleep);
+            scheduler.wait();
+        }
+        profiler.endFrame();
     }
+    profiler.writeCsv("profile.csv");
+    profiler.writeTrace("profile.json");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,114 @@
+#ifndef POOL_HPP
+#define POOL_HPP
+/*
+    Description: Pool for one object type with generational handles. Objects sit back to back
+        in one array, so iterating a pool walks contiguous memory of a single type with no
+        pointer chasing or virtual calls. Destroying moves the last object into the hole:
+        no gaps, and no allocation at all once the pool has grown to its peak size.
+        Handles go through a slot table holding each object's current index and a generation
+        bumped on destroy, so a handle to a destroyed object fails get() instead of reaching
+        whatever now lives there. Pointers and references are only good until the next
+        create or destroy; keep handles.
+*/
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace my {
+    template<class T>
+    class Pool {
+    public:
+        struct Handle {
+            std::uint32_t index, generation;//generation 0 is never live: a default handle is null.
+            bool operator==(const Handle& other) const {
+                return index == other.index && generation == other.generation;
+            }
+            bool operator!=(const Handle& other) const {
+                return !(*this == other);
+            }
+        };
+    private:
+        struct Slot {
+            std::uint32_t object, generation;
+        };
+        std::vector<T> objects;
+        std::vector<std::uint32_t> owners;  //Slot of each object.
+        std::vector<Slot> slots;
+        std::vector<std::uint32_t> freeSlots;
+    public:
+        void reserve(std::size_t count) {
+            objects.reserve(count);
+            owners.reserve(count);
+            slots.reserve(count);
+        }
+        template<class... Args>
+        Handle create(Args&&... args) {
+            std::uint32_t slot;
+            if (!freeSlots.empty()) {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+            }
+            else {
+                slot = static_cast<std::uint32_t>(slots.size());
+                slots.push_back(Slot{ 0, 1 });
+            }
+            slots[slot].object = static_cast<std::uint32_t>(objects.size());
+            objects.emplace_back(std::forward<Args>(args)...);
+            owners.push_back(slot);
+            return Handle{ slot, slots[slot].generation };
+        }
+        //False when the handle was already stale.
+        bool destroy(Handle handle) {
+            if (!alive(handle))
+                return false;
+            std::uint32_t object = slots[handle.index].object, last = static_cast<std::uint32_t>(objects.size()) - 1;
+            if (object != last) {
+                objects[object] = std::move(objects[last]);
+                owners[object] = owners[last];
+                slots[owners[object]].object = object;
+            }
+            objects.pop_back();
+            owners.pop_back();
+            ++slots[handle.index].generation;
+            freeSlots.push_back(handle.index);
+            return true;
+        }
+        bool alive(Handle handle) const {
+            return handle.index < slots.size() && slots[handle.index].generation == handle.generation;
+        }
+        //Null for stale handles.
+        T* get(Handle handle) {
+            return alive(handle) ? &objects[slots[handle.index].object] : nullptr;
+        }
+        const T* get(Handle handle) const {
+            return alive(handle) ? &objects[slots[handle.index].object] : nullptr;
+        }
+        //Handle of the object at index, for keeping hold of it across iterations.
+        Handle handle(std::size_t index) const {
+            return Handle{ owners[index], slots[owners[index]].generation };
+        }
+        std::size_t size() const {
+            return objects.size();
+        }
+        T& operator[](std::size_t index) {
+            return objects[index];
+        }
+        const T& operator[](std::size_t index) const {
+            return objects[index];
+        }
+        typename std::vector<T>::iterator begin() {
+            return objects.begin();
+        }
+        typename std::vector<T>::iterator end() {
+            return objects.end();
+        }
+        typename std::vector<T>::const_iterator begin() const {
+            return objects.begin();
+        }
+        typename std::vector<T>::const_iterator end() const {
+            return objects.end();
+        }
+    };
+}
+#endif // !POOL_HPP
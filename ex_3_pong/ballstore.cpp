@@ -0,0 +1,106 @@
+#include "ballstore.hpp"
+#include <algorithm>
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MY_SSE
+#include <xmmintrin.h>
+#endif
+
+my::BallStore::BallStore(float radius) : radius{ radius } {}
+std::size_t my::BallStore::size() const {
+    return x.size();
+}
+void my::BallStore::reserve(std::size_t count) {
+    for (auto array : { &x, &y, &vx, &vy, &dx, &dy })
+        array->reserve(count);
+}
+void my::BallStore::add(const sf::Vector2f& position, const sf::Vector2f& velocity, bool right, bool down) {
+    x.push_back(position.x);
+    y.push_back(position.y);
+    vx.push_back(velocity.x);
+    vy.push_back(velocity.y);
+    dx.push_back(right ? 1.f : -1.f);
+    dy.push_back(down ? 1.f : -1.f);
+}
+void my::BallStore::clear() {
+    for (auto array : { &x, &y, &vx, &vy, &dx, &dy })
+        array->clear();
+}
+sf::Vector2f my::BallStore::getPosition(std::size_t i) const {
+    return sf::Vector2f{ x[i], y[i] };
+}
+sf::Vector2f my::BallStore::getCenter(std::size_t i) const {
+    return sf::Vector2f{ x[i] + radius / 2, y[i] + radius / 2 };
+}
+void my::BallStore::setCenter(std::size_t i, const sf::Vector2f& center) {
+    x[i] = center.x - radius / 2;
+    y[i] = center.y - radius / 2;
+}
+sf::FloatRect my::BallStore::getBounds(std::size_t i) const {
+    //my::Ball sets its origin to half the radius, not the center.
+    return sf::FloatRect{ x[i] - radius / 2, y[i] - radius / 2, radius * 2, radius * 2 };
+}
+void my::BallStore::integrate(float delta, const sf::Vector2f& maxSpeed) {
+    std::size_t i = 0, count = size();
+    float *px = x.data(), *py = y.data(), *pvx = vx.data(), *pvy = vy.data();
+    const float *pdx = dx.data(), *pdy = dy.data();
+#if defined(__AVX__)
+    const __m256 d = _mm256_set1_ps(delta),
+                 hx = _mm256_set1_ps(maxSpeed.x), lx = _mm256_set1_ps(-maxSpeed.x),
+                 hy = _mm256_set1_ps(maxSpeed.y), ly = _mm256_set1_ps(-maxSpeed.y);
+    for (; i + 8 <= count; i += 8) {
+        __m256 vx8 = _mm256_add_ps(_mm256_loadu_ps(pvx + i), _mm256_mul_ps(_mm256_loadu_ps(pdx + i), d)),
+               vy8 = _mm256_add_ps(_mm256_loadu_ps(pvy + i), _mm256_mul_ps(_mm256_loadu_ps(pdy + i), d));
+        vx8 = _mm256_min_ps(_mm256_max_ps(vx8, lx), hx);
+        vy8 = _mm256_min_ps(_mm256_max_ps(vy8, ly), hy);
+        _mm256_storeu_ps(pvx + i, vx8);
+        _mm256_storeu_ps(pvy + i, vy8);
+        _mm256_storeu_ps(px + i, _mm256_add_ps(_mm256_loadu_ps(px + i), vx8));
+        _mm256_storeu_ps(py + i, _mm256_add_ps(_mm256_loadu_ps(py + i), vy8));
+    }
+#elif defined(MY_SSE)
+    const __m128 d = _mm_set1_ps(delta),
+                 hx = _mm_set1_ps(maxSpeed.x), lx = _mm_set1_ps(-maxSpeed.x),
+                 hy = _mm_set1_ps(maxSpeed.y), ly = _mm_set1_ps(-maxSpeed.y);
+    for (; i + 4 <= count; i += 4) {
+        __m128 vx4 = _mm_add_ps(_mm_loadu_ps(pvx + i), _mm_mul_ps(_mm_loadu_ps(pdx + i), d)),
+               vy4 = _mm_add_ps(_mm_loadu_ps(pvy + i), _mm_mul_ps(_mm_loadu_ps(pdy + i), d));
+        vx4 = _mm_min_ps(_mm_max_ps(vx4, lx), hx);
+        vy4 = _mm_min_ps(_mm_max_ps(vy4, ly), hy);
+        _mm_storeu_ps(pvx + i, vx4);
+        _mm_storeu_ps(pvy + i, vy4);
+        _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), vx4));
+        _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), vy4));
+    }
+#endif
+    //Scalar tail (or whole array without SIMD): same math, still branch-free.
+    for (; i < count; ++i) {
+        pvx[i] = std::min(std::max(pvx[i] + pdx[i] * delta, -maxSpeed.x), maxSpeed.x);
+        pvy[i] = std::min(std::max(pvy[i] + pdy[i] * delta, -maxSpeed.y), maxSpeed.y);
+        px[i] += pvx[i];
+        py[i] += pvy[i];
+    }
+}
+
+void my::integrate(Ball& ball, float delta, const sf::Vector2f& maxSpeed) {
+    if (ball.direction.x)
+        ball.velocity.x += delta;
+    else
+        ball.velocity.x -= delta;
+    if (ball.direction.y)
+        ball.velocity.y += delta;
+    else
+        ball.velocity.y -= delta;
+    //Clamped on both sides, as in BallStore::integrate: a ball turned around while faster
+    //than maxSpeed is slowed at once, not only once it accelerates the other way.
+    if (ball.velocity.x > maxSpeed.x)
+        ball.velocity.x = maxSpeed.x;
+    else if (ball.velocity.x < -maxSpeed.x)
+        ball.velocity.x = -maxSpeed.x;
+    if (ball.velocity.y > maxSpeed.y)
+        ball.velocity.y = maxSpeed.y;
+    else if (ball.velocity.y < -maxSpeed.y)
+        ball.velocity.y = -maxSpeed.y;
+    ball.move(ball.velocity);
+}
@@ -0,0 +1,35 @@
+#ifndef BALLSTORE_HPP
+#define BALLSTORE_HPP
+/*
+    Description: Structure-of-arrays ball storage. Positions, velocities and direction
+        signs live in separate contiguous arrays so the accelerate/clamp/integrate step
+        runs as one branch-free, vectorized pass over every ball.
+*/
+#include "shapes.hpp"
+#include <vector>
+
+namespace my {
+    class BallStore {
+    public:
+        //Velocity is distance per update step; direction is stored as a sign: +1 right/down, -1 left/up.
+        std::vector<float> x, y, vx, vy, dx, dy;
+        float radius;
+        BallStore(float radius = 25.f);
+        std::size_t size() const;
+        void reserve(std::size_t count);
+        void add(const sf::Vector2f& position, const sf::Vector2f& velocity, bool right, bool down);
+        void clear();
+        sf::Vector2f getPosition(std::size_t i) const;
+        //Center of the drawn circle, offset from the position by the half radius origin.
+        sf::Vector2f getCenter(std::size_t i) const;
+        void setCenter(std::size_t i, const sf::Vector2f& center);
+        //Same bounds as a my::Ball of this radius at the same position.
+        sf::FloatRect getBounds(std::size_t i) const;
+        //Accelerate each ball along its direction, clamp to maxSpeed and move it.
+        void integrate(float delta, const sf::Vector2f& maxSpeed);
+    };
+
+    //Per-object reference path: the branchy update of a single my::Ball, same results as the kernel.
+    void integrate(Ball& ball, float delta, const sf::Vector2f& maxSpeed);
+}
+#endif // !BALLSTORE_HPP
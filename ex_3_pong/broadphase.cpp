@@ -0,0 +1,50 @@
+#include "broadphase.hpp"
+#include <algorithm>
+#include <cmath>
+
+my::UniformGrid::UniformGrid(const sf::FloatRect& area, float cellSize) :
+    area{ area }, cellSize{ cellSize },
+    columns{ static_cast<std::size_t>(std::ceil(area.width / cellSize)) },
+    rows{ static_cast<std::size_t>(std::ceil(area.height / cellSize)) },
+    query_count{ 0 } {
+    columns = columns ? columns : 1;
+    rows = rows ? rows : 1;
+    cells.resize(columns * rows);
+}
+sf::Rect<std::size_t> my::UniformGrid::cover(const sf::FloatRect& bounds) const {
+    //Clamp to the grid: anything outside the area lands in the border cells.
+    auto cell = [this](float value, float origin, std::size_t count) -> std::size_t {
+        float index = std::floor((value - origin) / cellSize);
+        return index < 0 ? 0 : std::min(static_cast<std::size_t>(index), count - 1);
+    };
+    std::size_t left   = cell(bounds.left, area.left, columns),
+                top    = cell(bounds.top, area.top, rows),
+                right  = cell(bounds.left + bounds.width, area.left, columns),
+                bottom = cell(bounds.top + bounds.height, area.top, rows);
+    return sf::Rect<std::size_t>{ left, top, right - left + 1, bottom - top + 1 };
+}
+void my::UniformGrid::clear() {
+    for (auto& cell : cells)
+        cell.clear();
+}
+void my::UniformGrid::insert(std::size_t id, const sf::FloatRect& bounds) {
+    if (id >= stamps.size())
+        stamps.resize(id + 1, 0);
+    sf::Rect<std::size_t> range = cover(bounds);
+    for (std::size_t y = range.top; y < range.top + range.height; ++y)
+        for (std::size_t x = range.left; x < range.left + range.width; ++x)
+            cells[y * columns + x].push_back(id);
+}
+void my::UniformGrid::query(const sf::FloatRect& bounds, std::vector<std::size_t>& out) {
+    ++query_count;
+    std::size_t first = out.size();
+    sf::Rect<std::size_t> range = cover(bounds);
+    for (std::size_t y = range.top; y < range.top + range.height; ++y)
+        for (std::size_t x = range.left; x < range.left + range.width; ++x)
+            for (std::size_t id : cells[y * columns + x])
+                if (stamps[id] != query_count) {
+                    stamps[id] = query_count;
+                    out.push_back(id);
+                }
+    std::sort(out.begin() + first, out.end());
+}
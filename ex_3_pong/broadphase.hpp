@@ -0,0 +1,32 @@
+#ifndef BROADPHASE_HPP
+#define BROADPHASE_HPP
+/*
+    Description: Uniform grid broadphase. Colliders are bucketed by the cells their
+        bounds overlap; a query returns each collider sharing a cell with the query
+        rectangle once, so narrowphase only runs on nearby pairs.
+*/
+#include <SFML/Graphics/Rect.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace my {
+    class UniformGrid {
+    private:
+        sf::FloatRect area;
+        float cellSize;
+        std::size_t columns, rows;
+        std::vector<std::vector<std::size_t>> cells;
+        //Last query that reported each collider: avoids duplicates without a set.
+        std::vector<std::size_t> stamps;
+        std::size_t query_count;
+        sf::Rect<std::size_t> cover(const sf::FloatRect& bounds) const;
+    public:
+        UniformGrid(const sf::FloatRect& area, float cellSize);
+        //Empty every cell, keeping their capacity for the next rebuild.
+        void clear();
+        void insert(std::size_t id, const sf::FloatRect& bounds);
+        //Appends candidate ids overlapping the cells under bounds, in ascending order.
+        void query(const sf::FloatRect& bounds, std::vector<std::size_t>& out);
+    };
+}
+#endif // !BROADPHASE_HPP
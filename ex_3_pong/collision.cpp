@@ -0,0 +1,109 @@
+#include "collision.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    const float infinity = std::numeric_limits<float>::infinity();
+
+    //Ray vs circle of radius at point, smallest root in [0, 1].
+    bool rayCircle(const sf::Vector2f& origin, const sf::Vector2f& motion,
+                   const sf::Vector2f& point, float radius, float& time) {
+        sf::Vector2f offset = origin - point;
+        float a = motion.x * motion.x + motion.y * motion.y,
+              b = offset.x * motion.x + offset.y * motion.y,
+              c = offset.x * offset.x + offset.y * offset.y - radius * radius;
+        if (a <= 0 || b > 0)
+            return false;
+        float discriminant = b * b - a * c;
+        if (discriminant < 0)
+            return false;
+        time = (-b - std::sqrt(discriminant)) / a;
+        return time >= 0 && time <= 1;
+    }
+    //Slab entry and exit of one axis; false when parallel and outside.
+    bool slab(float origin, float motion, float low, float high, float& enter, float& exit) {
+        if (motion == 0) {
+            enter = -infinity;
+            exit = infinity;
+            return origin >= low && origin <= high;
+        }
+        float t0 = (low - origin) / motion, t1 = (high - origin) / motion;
+        enter = std::min(t0, t1);
+        exit = std::max(t0, t1);
+        return true;
+    }
+}
+
+my::Sweep my::sweep(const sf::Vector2f& center, float radius, const sf::Vector2f& motion, const sf::FloatRect& box) {
+    Sweep result{ false, 0, { 0, 0 }, 0 };
+    float right = box.left + box.width, bottom = box.top + box.height;
+
+    //Already touching: push out along the shortest way.
+    sf::Vector2f closest{ std::min(std::max(center.x, box.left), right),
+                          std::min(std::max(center.y, box.top), bottom) };
+    sf::Vector2f offset = center - closest;
+    float distance = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+    if (distance < radius) {
+        result.hit = true;
+        if (distance > 0) {
+            result.normal = offset / distance;
+            result.depth = radius - distance;
+        }
+        else {
+            //Center inside the box: leave through the nearest face.
+            float faces[4] = { center.x - box.left, right - center.x, center.y - box.top, bottom - center.y };
+            std::size_t face = std::min_element(faces, faces + 4) - faces;
+            sf::Vector2f normals[4] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+            result.normal = normals[face];
+            result.depth = faces[face] + radius;
+        }
+        return result;
+    }
+
+    //Ray against the box grown by radius on every side.
+    float enterX, exitX, enterY, exitY;
+    if (!slab(center.x, motion.x, box.left - radius, right + radius, enterX, exitX) ||
+        !slab(center.y, motion.y, box.top - radius, bottom + radius, enterY, exitY))
+        return result;
+    float enter = std::max(enterX, enterY), exit = std::min(exitX, exitY);
+    if (enter > exit || enter > 1 || exit < 0)
+        return result;
+
+    //Entry point beside a face: flat contact. Otherwise it is in a rounded corner.
+    sf::Vector2f point = center + motion * enter;
+    bool beside_x = point.x >= box.left && point.x <= right,
+         beside_y = point.y >= box.top && point.y <= bottom;
+    if (beside_x || beside_y) {
+        result.hit = true;
+        result.time = std::max(enter, 0.f);
+        if (enterX > enterY)
+            result.normal = { motion.x > 0 ? -1.f : 1.f, 0 };
+        else
+            result.normal = { 0, motion.y > 0 ? -1.f : 1.f };
+        return result;
+    }
+    sf::Vector2f corner{ point.x < box.left ? box.left : right, point.y < box.top ? box.top : bottom };
+    float time;
+    if (rayCircle(center, motion, corner, radius, time)) {
+        result.hit = true;
+        result.time = time;
+        result.normal = (center + motion * time - corner) / radius;
+    }
+    return result;
+}
+
+sf::Vector2f my::reflect(const Sweep& sweep, sf::Vector2f& center, sf::Vector2f& velocity, const sf::Vector2f& motion) {
+    center += sweep.normal * sweep.depth;
+    center += motion * sweep.time;
+    float into = velocity.x * sweep.normal.x + velocity.y * sweep.normal.y;
+    if (into < 0)
+        velocity -= sweep.normal * (2 * into);
+    //Remaining motion keeps its length but follows the reflected velocity.
+    float left = 1 - sweep.time,
+          length = std::sqrt(motion.x * motion.x + motion.y * motion.y),
+          speed = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
+    sf::Vector2f rest = speed > 0 ? velocity * (left * length / speed) : sf::Vector2f{ 0, 0 };
+    center += rest;
+    return rest;
+}
@@ -0,0 +1,27 @@
+#ifndef COLLISION_HPP
+#define COLLISION_HPP
+/*
+    Description: Continuous circle vs axis aligned box collision. A moving circle is
+        swept as a ray against the box grown by the radius (rounded corners), which
+        gives the time of impact and contact normal without stepping the motion.
+*/
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+namespace my {
+    struct Sweep {
+        bool hit;
+        float time;         //Fraction of the motion travelled before contact, [0, 1].
+        sf::Vector2f normal;//Unit normal of the box surface at contact.
+        float depth;        //Penetration when already overlapping at time 0.
+    };
+
+    //Sweeps a circle at center by motion against box.
+    Sweep sweep(const sf::Vector2f& center, float radius, const sf::Vector2f& motion, const sf::FloatRect& box);
+
+    //Resolves a sweep in one step: moves center to the contact, reflects velocity about the
+    //normal and spends the remaining motion along the reflected velocity.
+    //Returns the motion left over after contact (already applied to center).
+    sf::Vector2f reflect(const Sweep& sweep, sf::Vector2f& center, sf::Vector2f& velocity, const sf::Vector2f& motion);
+}
+#endif // !COLLISION_HPP
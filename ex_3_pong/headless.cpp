@@ -0,0 +1,141 @@
+#include "headless.hpp"
+#include "simulation.hpp"
+#include "ballstore.hpp"
+#include "collision.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+double my::HeadlessStats::stepsPerSecond() const {
+    return seconds > 0 ? steps / seconds : 0;
+}
+double my::HeadlessStats::stepsPerSecondPerCore() const {
+    return threads ? stepsPerSecond() / threads : 0;
+}
+double my::HeadlessStats::pairsPerStep() const {
+    return steps ? static_cast<double>(pairs) / steps : 0;
+}
+my::HeadlessStats my::runHeadless(std::size_t matches, std::size_t ticks, unsigned threads,
+                                  std::size_t balls, float ups) {
+    if (!threads)
+        threads = 1;
+    sf::FloatRect screen{ 0, 0, 800, 600 };
+    float delta = 1 / ups;
+
+    //Each worker plays matches [first, last) and seeds them by match index.
+    std::vector<std::size_t> pairs(threads, 0);
+    auto play = [=, &pairs](unsigned worker, std::size_t first, std::size_t last) {
+        std::size_t tested = 0;
+        for (std::size_t match = first; match < last; ++match) {
+            Simulation simulation{ screen, static_cast<unsigned>(match) };
+            while (simulation.balls.size() < balls)
+                simulation.addBall();
+            for (std::size_t tick = 0; tick < ticks; ++tick) {
+                simulation.step(autopilot(simulation), delta);
+                tested += simulation.pairsTested;
+            }
+        }
+        pairs[worker] = tested;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    std::size_t share = matches / threads, extra = matches % threads, first = 0;
+    for (unsigned i = 0; i < threads; ++i) {
+        std::size_t last = first + share + (i < extra ? 1 : 0);
+        workers.emplace_back(play, i, first, last);
+        first = last;
+    }
+    for (auto& worker : workers)
+        worker.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::size_t tested = 0;
+    for (std::size_t count : pairs)
+        tested += count;
+    return HeadlessStats{ matches, matches * ticks, balls, tested, threads, elapsed.count() };
+}
+
+my::BallBenchmark my::benchmarkBalls(std::size_t count, std::size_t ticks) {
+    std::mt19937 rand{ 0 };
+    std::uniform_real_distribution<float> position{ 0, 800 }, speed{ -maxSpeed.x, maxSpeed.x };
+    std::vector<Ball> objects;
+    objects.reserve(count);
+    BallStore store;
+    store.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        sf::Vector2f p{ position(rand), position(rand) }, v{ speed(rand), speed(rand) };
+        objects.emplace_back(store.radius, p, v, sf::Vector2<bool>{ rand() % 2 == 1, rand() % 2 == 1 });
+        store.add(p, v, objects.back().direction.x, objects.back().direction.y);
+    }
+    float delta = 1 / 120.f;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t tick = 0; tick < ticks; ++tick)
+        for (auto& ball : objects)
+            integrate(ball, delta, maxSpeed);
+    auto middle = std::chrono::steady_clock::now();
+    for (std::size_t tick = 0; tick < ticks; ++tick)
+        store.integrate(delta, maxSpeed);
+    auto end = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double> object = middle - start, soa = end - middle;
+    std::size_t mismatches = 0;
+    auto differ = [](float a, float b) { return std::abs(a - b) > 1e-3f * std::max(1.f, std::abs(a)); };
+    for (std::size_t i = 0; i < count; ++i) {
+        sf::Vector2f p = objects[i].getPosition(), v = objects[i].getVelocity();
+        if (differ(p.x, store.x[i]) || differ(p.y, store.y[i]) || differ(v.x, store.vx[i]) || differ(v.y, store.vy[i]))
+            ++mismatches;
+    }
+    return BallBenchmark{ count, ticks, object.count(), soa.count(), mismatches };
+}
+
+std::vector<my::CollisionBenchmark> my::benchmarkCollision(const std::vector<float>& speeds, std::size_t trials,
+                                                           std::size_t cap) {
+    std::mt19937 rand{ 0 };
+    std::uniform_real_distribution<float> depth{ 0.5f, 10.f };
+    Paddle paddle{ { 20, 120 }, { 100, 300 }, 0 };
+    sf::FloatRect bounds = paddle.getGlobalBounds();
+    std::vector<CollisionBenchmark> results;
+    for (float speed : speeds) {
+        CollisionBenchmark result{ speed, 0, 0, 0, false };
+        for (std::size_t trial = 0; trial < trials; ++trial) {
+            //Ball overlapping the paddle's right face, already reflected to move away.
+            BallStore balls;
+            float into = depth(rand);
+            balls.add({ 0, 0 }, { -speed, 0 }, false, true);
+            balls.setCenter(0, { bounds.left + bounds.width + balls.radius - into, 300 });
+            BallStore copy = balls;
+
+            //Old path: step by the (reflected) velocity until no longer intersecting.
+            auto start = std::chrono::steady_clock::now();
+            std::size_t steps = 0;
+            balls.vx[0] = -balls.vx[0];
+            while (balls.getBounds(0).intersects(bounds) && steps < cap) {
+                balls.x[0] += balls.vx[0];
+                balls.y[0] += balls.vy[0];
+                ++steps;
+            }
+            auto middle = std::chrono::steady_clock::now();
+
+            //Swept path: one contact and reflection regardless of speed.
+            sf::Vector2f velocity{ copy.vx[0], copy.vy[0] }, center{ copy.getCenter(0) - velocity };
+            Sweep contact = sweep(center, copy.radius, velocity, bounds);
+            if (contact.hit)
+                reflect(contact, center, velocity, velocity);
+            copy.setCenter(0, center);
+            auto end = std::chrono::steady_clock::now();
+
+            std::chrono::duration<double> loop = middle - start, swept = end - middle;
+            result.loopSeconds = std::max(result.loopSeconds, loop.count());
+            result.sweptSeconds = std::max(result.sweptSeconds, swept.count());
+            result.loopSteps = std::max(result.loopSteps, steps);
+            result.loopCapped = result.loopCapped || steps == cap;
+        }
+        results.push_back(result);
+    }
+    return results;
+}
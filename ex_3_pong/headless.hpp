@@ -0,0 +1,44 @@
+#ifndef HEADLESS_HPP
+#define HEADLESS_HPP
+/*
+    Description: Runs many simulated matches without a window, as fast as the CPU allows.
+        Matches are split evenly across worker threads, one simulation per match.
+*/
+#include <cstddef>
+#include <vector>
+
+namespace my {
+    struct HeadlessStats {
+        std::size_t matches, steps, balls;
+        //Narrowphase pairs tested over all steps.
+        std::size_t pairs;
+        unsigned threads;
+        double seconds;
+        double stepsPerSecond() const;
+        double stepsPerSecondPerCore() const;
+        double pairsPerStep() const;
+    };
+    struct BallBenchmark {
+        std::size_t balls, ticks;
+        double objectSeconds, storeSeconds;
+        std::size_t mismatches;//Balls whose position or velocity differ between the two afterwards.
+    };
+    //Times the per-object my::Ball update against BallStore::integrate on the same balls,
+    //then checks that both arrived at the same state.
+    BallBenchmark benchmarkBalls(std::size_t balls, std::size_t ticks);
+    struct CollisionBenchmark {
+        float speed;
+        //Worst single resolution over all trials, and most steps the old loop took.
+        double loopSeconds, sweptSeconds;
+        std::size_t loopSteps;
+        bool loopCapped;//Hit the step cap: the old loop would never have ended.
+    };
+    //Times "while intersects, move" depenetration against one swept resolution for a
+    //ball pushed into a paddle, once per speed, keeping the worst case of trials runs.
+    std::vector<CollisionBenchmark> benchmarkCollision(const std::vector<float>& speeds, std::size_t trials,
+                                                       std::size_t cap = 10000000);
+    //Runs each match for ticks fixed steps of 1/ups seconds with autopilot input.
+    HeadlessStats runHeadless(std::size_t matches, std::size_t ticks, unsigned threads,
+                              std::size_t balls = 1, float ups = 120.f);
+}
+#endif // !HEADLESS_HPP
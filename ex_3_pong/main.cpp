@@ -1,194 +1,232 @@
 #include <SFML/Graphics.hpp>
+#include "simulation.hpp"
+#include "headless.hpp"
+#include "replay.hpp"
+#include "../common/scheduler.hpp"
+#include "../common/profiler.hpp"
+#include "../common/input.hpp"
+#include "../common/triplebuffer.hpp"
+#include "../common/camera.hpp"
 
 #include <iostream>//For debugging
 #include <array>
-#include <memory>
-#include <random>
+#include <atomic>
+#include <cmath>
+#include <vector>
 #include <chrono>
+#include <string>
 #include <thread>
-#include <vector>
-#include <unordered_map>
 
-namespace my {
-    float paddleSpeed = 500;
-    sf::Vector2f maxSpeed{ 5, 5 };//Ball velocity max speed
-    //Input key bindings (sf::Keyboard::Keys will bind to these enum)
-    struct Input {
-        enum Key {
-            None,
-            Up,
-            Down,
-            Left,
-            Right,
-            Size
-        };
-    };
-
-    //Ball object
-    class Ball : public sf::CircleShape {
-    public:
-        sf::Vector2<bool> direction;
-        sf::Vector2f velocity;
-        Ball(float radius, const sf::Vector2f& position, const sf::Vector2f& velocity) :
-            sf::CircleShape{ radius }, velocity{ velocity }{
-            setPosition(position);
-            setOrigin(radius / 2, radius / 2);
-            //Ternary operation for acquiring direction
-            direction.x = rand() % 2 ? true : false;
-            direction.y = rand() % 2 ? true : false;
-        }
-        std::size_t getPointCount() const override {
-            return sf::CircleShape::getPointCount();
+//Everything drawing needs from the simulation: positions of the last tick and the one before.
+struct Snapshot {
+    std::array<sf::Vector2f, 2> paddles, previousPaddles;
+    std::vector<sf::Vector2f> balls, previousBalls;
+    my::Scheduler::Clock::time_point time;  //When the last tick finished.
+    float zoom = 1.f;                       //Camera zoom chosen by the player.
+    //Shift current into previous, then copy the simulation's positions in.
+    void capture(const my::Simulation& game) {
+        previousPaddles = paddles;
+        previousBalls.swap(balls);
+        for (std::size_t i = 0; i < game.paddles.size(); ++i)
+            paddles[i] = game.paddles[i].getPosition();
+        balls.resize(game.balls.size());
+        for (std::size_t i = 0; i < game.balls.size(); ++i)
+            balls[i] = game.balls.getPosition(i);
+        time = my::Scheduler::Clock::now();
+    }
+};
+
+//Shapes copied from the simulation once, then positioned from snapshots only.
+//Walls are drawn from the simulation's baked static geometry, which never changes once built.
+//Whatever the camera does not see is never submitted.
+struct Scene {
+    std::array<sf::RectangleShape, 2> paddles;
+    const my::StaticGeometry& walls;
+    sf::CircleShape ball;
+    float jump;     //Distance a ball covers only when reset to the center.
+    sf::FloatRect screen;
+    my::Camera camera;
+    explicit Scene(const my::Simulation& game) :
+        paddles{ { game.paddles[0], game.paddles[1] } }, walls{ game.statics },
+        ball{ game.balls.radius }, jump{ game.screen.width / 4 }, screen{ game.screen }, camera{ game.screen } {
+        ball.setOrigin(game.balls.radius / 2, game.balls.radius / 2);
+    }
+    void draw(sf::RenderTarget& target, const Snapshot& snapshot, float alpha) {
+        camera.reset(screen);
+        camera.zoom(snapshot.zoom);
+        camera.apply(target);
+        sf::FloatRect view = camera.getBounds();
+        std::size_t visible = 0;
+        for (std::size_t i = 0; i < paddles.size(); ++i) {
+            paddles[i].setPosition(my::lerp(snapshot.previousPaddles[i], snapshot.paddles[i], alpha));
+            if (!view.intersects(paddles[i].getGlobalBounds()))
+                continue;
+            target.draw(paddles[i]);
+            ++visible;
         }
-        sf::Vector2f getPoint(std::size_t index) const override {
-            return sf::CircleShape::getPoint(index);
+        //Balls are plain data: stamp one circle at each position.
+        for (std::size_t i = 0; i < snapshot.balls.size(); ++i) {
+            const sf::Vector2f& current = snapshot.balls[i];
+            //A ball reset to the center this tick jumps instead of sliding across.
+            bool reset = i >= snapshot.previousBalls.size() || std::abs(current.x - snapshot.previousBalls[i].x) > jump;
+            ball.setPosition(reset ? current : my::lerp(snapshot.previousBalls[i], current, alpha));
+            //Balls have no index of their own: a box test is cheaper than building one per frame.
+            if (!view.intersects(ball.getGlobalBounds()))
+                continue;
+            target.draw(ball);
+            ++visible;
         }
-    };
+        //Walls are one baked draw whatever the view.
+        target.draw(walls);
+        camera.count(visible, paddles.size() + snapshot.balls.size());
+    }
+};
+
+int main(int argc, char* argv[]) {
+    //Headless mode: pong --headless [matches] [ticks] [threads] [balls]
+    //  Runs simulated matches with scripted input and no window, then prints throughput.
+    if (argc > 1 && std::string{ argv[1] } == "--headless") {
+        std::size_t matches = argc > 2 ? std::stoul(argv[2]) : 1000,
+                    ticks   = argc > 3 ? std::stoul(argv[3]) : 1200;
+        unsigned threads = argc > 4 ? static_cast<unsigned>(std::stoul(argv[4])) : std::thread::hardware_concurrency();
+        std::size_t balls = argc > 5 ? std::stoul(argv[5]) : 1;
+        my::HeadlessStats stats = my::runHeadless(matches, ticks, threads, balls);
+        std::cout << stats.matches << " matches, " << stats.steps << " steps in " << stats.seconds << "s\n"
+                  << stats.stepsPerSecond() << " steps/s, "
+                  << stats.stepsPerSecondPerCore() << " steps/s/core (" << stats.threads << " threads)\n"
+                  << stats.pairsPerStep() << " pairs tested/step with " << stats.balls << " balls\n";
+        return 0;
+    }
 
-    //Wall
-    class Wall : public sf::RectangleShape {
-    public:
-        Wall(const sf::Vector2f& size, const sf::Vector2f& position) :
-            sf::RectangleShape{ size } {
-            setPosition(position);
-            setOrigin(size.x / 2, size.y / 2);
-        }
-        void move(float x, float y) {
-            setPosition(getPosition().x + x, getPosition().y + y);
-        }
-        void move(const sf::Vector2f position) {
-            setPosition(getPosition().x + position.x, getPosition().y + position.y);
-        }
-        std::size_t getPointCount() const override {
-            return sf::RectangleShape::getPointCount();
-        }
-        sf::Vector2f getPoint(std::size_t index) const override {
-            return sf::RectangleShape::getPoint(index);
-        }
-    };
+    //Ball benchmark: pong --bench-balls [balls] [ticks]
+    //  Compares the per-object ball update with the structure-of-arrays kernel.
+    if (argc > 1 && std::string{ argv[1] } == "--bench-balls") {
+        std::size_t balls = argc > 2 ? std::stoul(argv[2]) : 50000,
+                    ticks = argc > 3 ? std::stoul(argv[3]) : 1000;
+        my::BallBenchmark bench = my::benchmarkBalls(balls, ticks);
+        double updates = static_cast<double>(bench.balls) * bench.ticks;
+        std::cout << bench.balls << " balls x " << bench.ticks << " ticks\n"
+                  << "per-object: " << bench.objectSeconds * 1e9 / updates << " ns/ball\n"
+                  << "soa kernel: " << bench.storeSeconds * 1e9 / updates << " ns/ball\n"
+                  << bench.mismatches << " balls differ between the two\n";
+        return 0;
+    }
 
-    //Player
-    class Paddle : public sf::RectangleShape {
-    private:
-    public:
-        std::unordered_map<sf::Keyboard::Key, std::pair<Input::Key, bool>> inputs;
-        std::size_t score;
-        Paddle(const sf::Vector2f& size, const sf::Vector2f& position, const std::size_t& score) :
-            sf::RectangleShape{ size }, score{ score } {
-            setPosition(position);
-            setOrigin(size.x / 2, size.y / 2);
-        }
-        void move(float x, float y) {
-            setPosition(getPosition().x + x, getPosition().y + y);
-        }
-        void move(const sf::Vector2f position) {
-            setPosition(getPosition().x + position.x, getPosition().y + position.y);
+    //Collision benchmark: pong --bench-collision [trials]
+    //  Worst case time to resolve a ball inside a paddle, across ball speeds.
+    if (argc > 1 && std::string{ argv[1] } == "--bench-collision") {
+        std::size_t trials = argc > 2 ? std::stoul(argv[2]) : 1000;
+        for (const auto& bench : my::benchmarkCollision({ 0.f, 0.001f, 0.01f, 0.1f, 1.f, 5.f, 50.f }, trials)) {
+            std::cout << "speed " << bench.speed
+                      << "\tloop: " << bench.loopSeconds * 1e6 << "us (" << bench.loopSteps << " steps"
+                      << (bench.loopCapped ? ", capped" : "") << ")"
+                      << "\tswept: " << bench.sweptSeconds * 1e6 << "us\n";
         }
-        void move(my::Input::Key key, float value = 1) {
-            value *= paddleSpeed;
-            switch (key) {
-            case Input::Up:
-                setPosition(getPosition().x + 0, getPosition().y - value);
-                break;
-            case Input::Down:
-                setPosition(getPosition().x + 0, getPosition().y + value);
-                break;
-            case Input::Left:
-                setPosition(getPosition().x - value, getPosition().y + 0);
-                break;
-            case Input::Right:
-                setPosition(getPosition().x + value, getPosition().y + 0);
-                break;
-            }
-        }
-        std::size_t getPointCount() const override {
-            return sf::RectangleShape::getPointCount();
-        }
-        sf::Vector2f getPoint(std::size_t index) const override {
-            return sf::RectangleShape::getPoint(index);
-        }
-        //Update value at key
-        void setInput(sf::Keyboard::Key key, bool value) {
-            auto it = inputs.find(key);
-            if (it != inputs.end())
-                inputs[key].second = value;
-        }
-        //Returns the slope value of a point relative to this objects origin.
-        float getSlope(float x, float y) {
-            return x - getOrigin().x ? (y - getOrigin().y) / (x - getOrigin().x) : 0;
-        }
-        float getSlope(const sf::Vector2f& point) {
-            return point.x - getPosition().x ? (point.y - getPosition().y) / (point.x - getPosition().x) : 0;
-        }
-        //Returns the slope value of self relative to this objects origin.
-        float getSlope() {
-            return getSlope(0, 0);
-        }
-        //Bind Key and value
-        void setInput(sf::Keyboard::Key key, Input::Key bind, bool value = false) {
-            if (bind != Input::Key::None) {
-                inputs[key] = std::pair<Input::Key, bool>{bind, value};
-            }
-            else {
-                auto it = inputs.find(key);
-                if (it != inputs.end())
-                    inputs.erase(it);
-            }
-        }
-        bool getInput(const sf::Keyboard::Key& key) {
-            auto it = inputs.find(key);
-            if (it != inputs.end())
-                return inputs[key].second;
-            return false;
-        }
-    };
-}
+        return 0;
+    }
 
+    sf::Rect<float> screen{ 0,0,800,600 };
 
-int main() {
-    //std::random_device not implemented on all compilers, using c++ system clock seed value.
-    std::mt19937 rand{ static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()) };
+    //Replay: pong --replay file
+    //  Re-runs a recorded match at full speed without rendering and checks the result.
+    if (argc > 2 && std::string{ argv[1] } == "--replay") {
+        my::Recording recording;
+        if (!recording.load(argv[2])) {
+            std::cout << "Can not read recording " << argv[2] << '\n';
+            return 1;
+        }
+        my::ReplayResult result = my::replay(recording, screen);
+        std::cout << result.ticks << " ticks in " << result.seconds << "s ("
+                  << (result.seconds > 0 ? result.ticks / result.seconds : 0) << " ticks/s), checksum "
+                  << std::hex << result.checksum << std::dec << (result.matches ? " matches\n" : " differs\n");
+        return result.matches ? 0 : 2;
+    }
+    //Record: pong --record file
+    //  Plays normally and saves the seed and every tick's input to file on exit.
+    std::string recordPath = argc > 2 && std::string{ argv[1] } == "--record" ? argv[2] : "";
+    //Threaded: pong [--record file] --threaded
+    //  Draws on a second thread from published snapshots, so a slow display never delays a tick.
+    bool threaded = false;
+    for (int i = 1; i < argc; ++i)
+        threaded = threaded || std::string{ argv[i] } == "--threaded";
 
-    sf::Rect<float> screen{ 0,0,800,600 };
     sf::RenderWindow window{ sf::VideoMode{ static_cast<unsigned int>(screen.width), 
                                             static_cast<unsigned int>(screen.height)},
                              "SFML Example Pong" };
 
-    //Entity parameters
-    sf::Vector2<float> size{ screen.width / 40.f, screen.height / 5.f },
-                       left_position{ size.x, screen.height / 2},
-                       right_position{ screen.width - size.x, screen.height / 2 };
-
-    //Ball parameters
-    float radius = 25.f;
-    sf::Vector2<float> middle_position{screen.width / 2, screen.height / 2 }, velocity{ 0,0 };
-
-    //Wall parameter
-    sf::Vector2<float> wSize{ screen.width, screen.height / 50.f };
-
+    //std::random_device not implemented on all compilers, using c++ system clock seed value.
+    unsigned int seed = static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count());
+    my::Simulation game{ screen, seed };
 
     float dps = 60.f,   //Draws per second
-          ups = 120.f,  //Updates per second
-          sps = 240.f;  //Sleeps per second
+          ups = 120.f;  //Updates per second
 
-    std::size_t fps = 0;
+    std::size_t fps = 0;//Frames drawn this second when drawing on this thread.
+    //Mouse wheel zoom around the middle of the court, and what the last draw kept of it.
+    float zoom = 1.f;
+    std::atomic<std::size_t> visible{ 0 }, total{ 0 };
 
     //Time Management: 
     //  First:  Accumulated delta change
     //  Second: Limit of delta change before acting.
-    std::pair<float, float> print{ 0.f, 1.f },      //Once per second
-                            draw{ 0.f, 1 / dps },   //varies depending on Draws Per Second var
-                            update{ 0.f, 1 / ups }; //varies depending on Updates Per Second var
-
-    sf::Clock clock;
-
-    //Construct left and right player
-    my::Paddle left{ size, left_position, 0 }, right{ size, right_position, 0 };
+    std::pair<float, float> print{ 0.f, 1.f };      //Once per second
+
+    //Fixed updates with catch-up, paced draws, sleeps until the next deadline.
+    my::Scheduler scheduler{ ups, dps };
+    my::Recording recording{ seed, scheduler.getStep() };
+    my::Profiler profiler;
+
+    //Positions of the last two ticks, for interpolated drawing.
+    Snapshot snapshot;
+    snapshot.capture(game);
+    snapshot.capture(game);
+    Scene scene{ game };
+
+    //Threaded mode: the simulation publishes snapshots, the render thread draws the newest.
+    my::TripleBuffer<Snapshot> snapshots;
+    std::atomic<bool> drawing{ true };
+    std::atomic<std::size_t> frames{ 0 };
+    my::Profiler renderProfiler;
+    std::thread renderer;
+    if (threaded) {
+        snapshots.back() = snapshot;
+        snapshots.publish();
+        //The context moves to the render thread: it alone draws and displays from here on.
+        window.setActive(false);
+        float step = scheduler.getStep();
+        renderer = std::thread{ [&, step]() {
+            window.setActive(true);
+            my::Scheduler pacing{ dps, dps };
+            while (drawing) {
+                pacing.advance();
+                renderProfiler.beginFrame();
+                if (pacing.drawDue()) {
+                    my::Profiler::Scope scope(renderProfiler, my::Phase::Draw);
+                    snapshots.update();
+                    const Snapshot& latest = snapshots.front();
+                    //Same lag as the single thread alpha: time since the tick in steps, held at 1 when the next is late.
+                    float alpha = std::chrono::duration<float>(my::Scheduler::Clock::now() - latest.time).count() / step;
+                    window.clear();
+                    scene.draw(window, latest, std::min(alpha, 1.f));
+                    visible = scene.camera.visible;
+                    total = scene.camera.total;
+                    window.display();
+                    ++frames;
+                }
+                {
+                    my::Profiler::Scope scope(renderProfiler, my::Phase::Sleep);
+                    pacing.wait();
+                }
+                renderProfiler.endFrame();
+            }
+            window.setActive(false);
+        } };
+    }
 
     //(Array)Map first player to left and second player to right (by address)
     std::array<my::Paddle*, 2> paddles{
-        &left,
-        &right
+        &game.paddles[0],
+        &game.paddles[1]
     };
 
     paddles[0]->setInput(sf::Keyboard::W, my::Input::Up);
@@ -201,145 +239,96 @@ int main() {
     //paddles[1]->setInput(sf::Keyboard::Left, my::Input::Left);
     //paddles[1]->setInput(sf::Keyboard::Right, my::Input::Right);
 
-    //(Vector growable)List of balls (my value).
-    std::vector<my::Ball> balls{
-        my::Ball{ radius, middle_position, velocity}
-    };
-    std::array<my::Wall, 2> walls{
-        my::Wall{ wSize, sf::Vector2f{ screen.width / 2, 0 }},
-        my::Wall{ wSize, sf::Vector2f{ screen.width / 2, screen.height}},
-    };
-    std::cout << walls[0].getPosition().x << ' ' << walls[0].getPosition().y << '\n';
-    std::cout << walls[1].getPosition().x << ' ' << walls[1].getPosition().y << '\n';
+    //Keyboard state fed by key events, snapshotted once per frame.
+    my::InputState keyState;
+
+    std::cout << game.walls[0].getPosition().x << ' ' << game.walls[0].getPosition().y << '\n';
+    std::cout << game.walls[1].getPosition().x << ' ' << game.walls[1].getPosition().y << '\n';
 
     bool running = true;
     while (running && window.isOpen()) {
-        float delta = clock.getElapsedTime().asSeconds();
-        clock.restart();
+        profiler.beginFrame();
+        std::size_t steps = scheduler.advance();
 
-        print.first += delta;
+        print.first += scheduler.delta;
         if (print.first > print.second) {
             print.first -= print.second;
+            profiler.print(std::cout);
+            std::cout << visible << '/' << total << " visible\n";
+            if (threaded) {
+                std::cout << frames.exchange(0) << " frames drawn\n";
+                renderProfiler.print(std::cout);
+            }
+            else
+                std::cout << fps << " frames drawn\n";
             fps = 0;
         }
 
         sf::Event event;
+        my::Profiler::Clock::time_point polling = my::Profiler::Clock::now();
         while (window.pollEvent(event)) {
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Escape) || event.type == sf::Event::Closed)
+            if ((event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) ||
+                event.type == sf::Event::Closed)
                 running = false;
-            
-            //Evaluate if directional key pressed.
-            for (auto i = 0; i < paddles.size(); ++i) {
-                for (const auto& input : paddles[i]->inputs) {
-                    paddles[i]->setInput(input.first, sf::Keyboard::isKeyPressed(input.first));
-                }
-            }
+            keyState.handle(event);
+            if (event.type == sf::Event::LostFocus)
+                keyState.releaseAll();
+            if (event.type == sf::Event::MouseWheelScrolled)
+                zoom *= event.mouseWheelScroll.delta > 0 ? 0.9f : 1.1f;
         }
-
-        update.first += delta;
-        if (update.first > update.second) {
-            //Update player movements: based on input map state
-            for (std::size_t i = 0; i < paddles.size(); ++i) {
-                for (const auto& input : paddles[i]->inputs) {
-                    auto key = &input.second;
-                    if (key->second)
-                        paddles[i]->move(key->first, update.first);
-                    for (const auto& wall : walls) {
-                        if (paddles[i]->getGlobalBounds().intersects(wall.getGlobalBounds())) {
-                            paddles[i]->move(key->first, -update.first);
-                        }
-                    }
-                }
-            }
-            //Check Ball State
-            for (auto i = 0; i < balls.size(); ++i) {
-
-                //Check ball to screen collision state: if outside, set to center and reset.
-                if (!balls[i].getGlobalBounds().intersects(screen)) {
-                    if (balls[i].getPosition().x > screen.width / 2)
-                        ++paddles[0]->score;
-                    else
-                        ++paddles[1]->score;
-                    balls[i].direction.x = rand() % 2 ? true : false;
-                    balls[i].direction.y = rand() % 2 ? true : false;
-                    balls[i].velocity.x = 0;
-                    balls[i].velocity.y = 0;
-                    balls[i].setPosition(screen.width / 2, screen.height / 2);
-                }
-
-                //Check ball to wall collision state: if collision, reverse velocity and direction
-                for (auto j = 0; j < walls.size(); ++j) {
-                    if (balls[i].getGlobalBounds().intersects(
-                        walls[j].getGlobalBounds())) {
-                        balls[i].direction.y = !balls[i].direction.y;
-                        balls[i].velocity.y  = -balls[i].velocity.y;
-                    }
-                }
-
-                //Check ball to paddle collision state
-                for (auto &paddle : paddles) {
-                    if (balls[i].getGlobalBounds().intersects(
-                        paddle->getGlobalBounds())) {
-                        if (std::abs(paddle->getSlope()) > std::abs(paddle->getSlope(balls[i].getPosition()))) {
-                            balls[i].velocity.x = -balls[i].velocity.x;
-                            while(balls[i].getGlobalBounds().intersects(paddle->getGlobalBounds()))
-                                balls[i].move(balls[i].velocity);
-                            balls[i].direction.x = !balls[i].direction.x;
-                        }
-                        else{
-                            balls[i].velocity.y = -balls[i].velocity.y;
-                            while (balls[i].getGlobalBounds().intersects(paddle->getGlobalBounds()))
-                                balls[i].move(balls[i].velocity);
-                            balls[i].direction.y = !balls[i].direction.y;
-                        }
-                    }
-                }
-
-                //Accumulate velocity for ball:
-                if (balls[i].direction.x) {
-                    balls[i].velocity.x += update.first;
-                    balls[i].velocity.x = balls[i].velocity.x > my::maxSpeed.x ?
-                        my::maxSpeed.x : balls[i].velocity.x;
-                }
-                else {
-                    balls[i].velocity.x -= update.first;
-                    balls[i].velocity.x = balls[i].velocity.x < -my::maxSpeed.x ?
-                        -my::maxSpeed.x : balls[i].velocity.x;
-                }
-                if (balls[i].direction.y) {
-                    balls[i].velocity.y += update.first;
-                    balls[i].velocity.y = balls[i].velocity.y > my::maxSpeed.y ?
-                        my::maxSpeed.y : balls[i].velocity.y;
-                }
-                else {
-                    balls[i].velocity.y -= update.first;
-                    balls[i].velocity.y = balls[i].velocity.y < -my::maxSpeed.y ?
-                        -my::maxSpeed.y : balls[i].velocity.y;
-                }
-
-                //Update ball position:
-                balls[i].move(balls[i].velocity);
+        //Evaluate if directional key pressed: from this frame's snapshot only.
+        my::KeySnapshot keys = keyState.snapshot();
+        for (auto& paddle : paddles)
+            paddle->keys = keys.down & paddle->inputs.getMask();
+
+        profiler.add(my::Phase::Events, polling, my::Profiler::Clock::now());
+
+        while (steps--) {
+            my::Profiler::Scope scope(profiler, my::Phase::Update);
+            //Translate the bound keyboard state into this tick's input frame.
+            my::InputFrame frame;
+            for (std::size_t i = 0; i < paddles.size(); ++i)
+                paddles[i]->inputs.forEachHeld(paddles[i]->keys, [&frame, i](sf::Keyboard::Key, my::Input::Key bind) {
+                    frame.set(i, bind, true);
+                });
+            game.step(frame, scheduler.getStep());
+            snapshot.capture(game);
+            snapshot.zoom = zoom;
+            if (!recordPath.empty())
+                recording.record(frame);
+            //Publish once the frame's last tick is in: earlier ones would never be drawn.
+            if (threaded && !steps) {
+                snapshots.back() = snapshot;
+                snapshots.publish();
             }
-            while(update.first > update.second)
-                update.first -= update.second;
         }
 
-        draw.first += delta;
-        if (draw.first > draw.second) {
+        if (!threaded && scheduler.drawDue()) {
+            my::Profiler::Scope scope(profiler, my::Phase::Draw);
             window.clear();
-            for (const auto& paddle : paddles)
-                window.draw(*paddle);
-            for (const auto& ball : balls)
-                window.draw(ball);
-            for (const auto& wall : walls)
-                window.draw(wall);
+            scene.draw(window, snapshot, scheduler.getAlpha());
+            visible = scene.camera.visible;
+            total = scene.camera.total;
             window.display();
             ++fps;
-            while(draw.first > draw.second)
-                draw.first -= draw.second;
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<long>(1000 / sps)));
+        {
+            my::Profiler::Scope scope(profiler, my::Phase::Sleep);
+            scheduler.wait();
+        }
+        profiler.endFrame();
+    }
+    if (threaded) {
+        drawing = false;
+        renderer.join();
+        window.setActive(true);
+    }
+    profiler.writeCsv("profile.csv");
+    profiler.writeTrace("profile.json");
+    if (!recordPath.empty()) {
+        recording.checksum = game.checksum();
+        recording.save(recordPath);
     }
     window.close();
     return 0;
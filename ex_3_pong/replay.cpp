@@ -0,0 +1,100 @@
+#include "replay.hpp"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    const char magic[4] = { 'P', 'O', 'N', 'G' };
+    const std::uint8_t version = 1;
+
+    void write(std::ostream& out, std::uint64_t value, std::size_t bytes) {
+        for (std::size_t i = 0; i < bytes; ++i)
+            out.put(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+    std::uint64_t read(std::istream& in, std::size_t bytes) {
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < bytes; ++i)
+            value |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(in.get())) << (i * 8);
+        return value;
+    }
+    void writeVarint(std::ostream& out, std::uint64_t value) {
+        do {
+            std::uint8_t byte = value & 0x7f;
+            value >>= 7;
+            out.put(static_cast<char>(byte | (value ? 0x80 : 0)));
+        } while (value);
+    }
+    std::uint64_t readVarint(std::istream& in) {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; in && shift < 64; shift += 7) {
+            std::uint8_t byte = static_cast<std::uint8_t>(in.get());
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                break;
+        }
+        return value;
+    }
+    std::uint32_t bits(float value) {
+        std::uint32_t result;
+        std::memcpy(&result, &value, sizeof result);
+        return result;
+    }
+}
+
+my::Recording::Recording(unsigned seed, float step) : seed{ seed }, step{ step }, checksum{ 0 } {}
+void my::Recording::record(const InputFrame& frame) {
+    frames.push_back(frame);
+}
+bool my::Recording::save(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    file.write(magic, sizeof magic);
+    write(file, version, 1);
+    write(file, seed, 4);
+    write(file, bits(step), 4);
+    write(file, frames.size(), 4);
+    write(file, checksum, 8);
+    //Inputs change rarely: store each frame once with how many ticks it repeats.
+    for (std::size_t i = 0; i < frames.size(); ) {
+        std::size_t run = 1;
+        while (i + run < frames.size() && frames[i + run].paddles == frames[i].paddles)
+            ++run;
+        writeVarint(file, run);
+        for (auto paddle : frames[i].paddles)
+            write(file, paddle, 1);
+        i += run;
+    }
+    return file.good();
+}
+bool my::Recording::load(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    char header[sizeof magic];
+    if (!file.read(header, sizeof header) || std::memcmp(header, magic, sizeof magic) || read(file, 1) != version)
+        return false;
+    seed = static_cast<unsigned>(read(file, 4));
+    std::uint32_t step_bits = static_cast<std::uint32_t>(read(file, 4));
+    std::memcpy(&step, &step_bits, sizeof step);
+    std::size_t ticks = static_cast<std::size_t>(read(file, 4));
+    checksum = read(file, 8);
+    frames.clear();
+    frames.reserve(ticks);
+    while (file && frames.size() < ticks) {
+        std::size_t run = static_cast<std::size_t>(readVarint(file));
+        InputFrame frame;
+        for (auto& paddle : frame.paddles)
+            paddle = static_cast<std::uint8_t>(read(file, 1));
+        if (!file || !run || frames.size() + run > ticks)
+            return false;
+        frames.insert(frames.end(), run, frame);
+    }
+    return frames.size() == ticks;
+}
+
+my::ReplayResult my::replay(const Recording& recording, const sf::FloatRect& screen) {
+    auto start = std::chrono::steady_clock::now();
+    Simulation simulation{ screen, recording.seed };
+    for (const auto& frame : recording.frames)
+        simulation.step(frame, recording.step);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::uint64_t checksum = simulation.checksum();
+    return ReplayResult{ recording.frames.size(), checksum, checksum == recording.checksum, elapsed.count() };
+}
@@ -0,0 +1,40 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+/*
+    Description: Deterministic input recording for the Pong simulation.
+        A recording is the seed, the fixed step and one InputFrame per tick. Played back
+        through a fresh Simulation on the same build it reproduces the match bit for bit;
+        the final state checksum is stored so a replay can prove it.
+
+    File format (little endian):
+        "PONG" u8 version, u32 seed, f32 step, u32 ticks, u64 checksum,
+        then runs of identical frames: varint run length, one byte per paddle.
+*/
+#include "simulation.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace my {
+    class Recording {
+    public:
+        unsigned seed;
+        float step;
+        std::vector<InputFrame> frames;
+        std::uint64_t checksum;//Simulation::checksum after the last frame.
+        Recording(unsigned seed = 0, float step = 1 / 120.f);
+        void record(const InputFrame& frame);
+        bool save(const std::string& filename) const;
+        bool load(const std::string& filename);
+    };
+
+    struct ReplayResult {
+        std::size_t ticks;
+        std::uint64_t checksum;
+        bool matches;//Checksum equals the recorded one.
+        double seconds;
+    };
+    //Plays a recording as fast as possible, no window and no rendering.
+    ReplayResult replay(const Recording& recording, const sf::FloatRect& screen);
+}
+#endif // !REPLAY_HPP
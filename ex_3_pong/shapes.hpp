@@ -0,0 +1,116 @@
+#ifndef SHAPES_HPP
+#define SHAPES_HPP
+/*
+    Description: Pong game objects. Ball, Wall and Paddle extend the SFML shapes so they
+        can be drawn directly, but hold no reference to a window. Their world bounds are
+        cached and only recomputed after they move; the benchmark ball's velocity comes
+        from my::Kinematic. None override SFML's getPointCount/getPoint: the base versions serve.
+*/
+#include <SFML/Graphics.hpp>
+#include "../common/bindings.hpp"
+#include "../common/kinematic.hpp"
+
+namespace my {
+    extern float paddleSpeed;
+    extern sf::Vector2f maxSpeed;//Ball velocity max speed
+    //Input key bindings (sf::Keyboard::Keys will bind to these enum)
+    struct Input {
+        enum Key {
+            None,
+            Up,
+            Down,
+            Left,
+            Right,
+            Size
+        };
+    };
+
+    //Ball object. Benchmark only: the game keeps its balls in a BallStore, and
+    //benchmarkBalls times this per-object version against it. Like BallStore, velocity
+    //is distance per update step, moved by my::integrate and never by Kinematic::step.
+    class Ball : public Kinematic<sf::CircleShape> {
+    public:
+        sf::Vector2<bool> direction;
+        //Direction comes from the caller's seeded generator: no hidden global rand().
+        Ball(float radius, const sf::Vector2f& position, const sf::Vector2f& velocity,
+             const sf::Vector2<bool>& direction) :
+            Kinematic<sf::CircleShape>{ radius }, direction{ direction } {
+            setVelocity(velocity);
+            setPosition(position);
+            setOrigin(radius / 2, radius / 2);
+        }
+    };
+
+    //Wall
+    class Wall : public CachedBounds<sf::RectangleShape> {
+    public:
+        Wall(const sf::Vector2f& size, const sf::Vector2f& position) :
+            CachedBounds<sf::RectangleShape>{ size } {
+            setPosition(position);
+            setOrigin(size.x / 2, size.y / 2);
+        }
+    };
+
+    //Player
+    class Paddle : public CachedBounds<sf::RectangleShape> {
+    private:
+    public:
+        BindingTable<Input::Key> inputs;//Keyboard key to paddle input.
+        KeyState keys;                  //Bound keys currently held.
+        std::size_t score;
+        Paddle(const sf::Vector2f& size, const sf::Vector2f& position, const std::size_t& score) :
+            CachedBounds<sf::RectangleShape>{ size }, score{ score } {
+            setPosition(position);
+            setOrigin(size.x / 2, size.y / 2);
+        }
+        using CachedBounds<sf::RectangleShape>::move;
+        void move(my::Input::Key key, float value = 1) {
+            value *= paddleSpeed;
+            switch (key) {
+            case Input::Up:
+                setPosition(getPosition().x + 0, getPosition().y - value);
+                break;
+            case Input::Down:
+                setPosition(getPosition().x + 0, getPosition().y + value);
+                break;
+            case Input::Left:
+                setPosition(getPosition().x - value, getPosition().y + 0);
+                break;
+            case Input::Right:
+                setPosition(getPosition().x + value, getPosition().y + 0);
+                break;
+            }
+        }
+        //Update value at key
+        void setInput(sf::Keyboard::Key key, bool value) {
+            if (inputs.isBound(key))
+                keys[key] = value;
+        }
+        //Returns the slope value of a point relative to this objects origin.
+        float getSlope(float x, float y) {
+            return x - getOrigin().x ? (y - getOrigin().y) / (x - getOrigin().x) : 0;
+        }
+        float getSlope(const sf::Vector2f& point) {
+            return point.x - getPosition().x ? (point.y - getPosition().y) / (point.x - getPosition().x) : 0;
+        }
+        //Returns the slope value of self relative to this objects origin.
+        float getSlope() {
+            return getSlope(0, 0);
+        }
+        //Bind Key and value
+        void setInput(sf::Keyboard::Key key, Input::Key bind, bool value = false) {
+            if (bind != Input::Key::None) {
+                inputs.bind(key, bind);
+                keys[key] = value;
+            }
+            else {
+                inputs.unbind(key);
+                keys[key] = false;
+            }
+        }
+        bool getInput(const sf::Keyboard::Key& key) {
+            return inputs.isBound(key) && keys[key];
+        }
+    };
+}
+#endif // !SHAPES_HPP
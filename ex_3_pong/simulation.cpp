@@ -0,0 +1,179 @@
+#include "simulation.hpp"
+#include "collision.hpp"
+#include <algorithm>
+#include <cmath>
+
+float my::paddleSpeed = 500;
+sf::Vector2f my::maxSpeed{ 5, 5 };
+
+void my::InputFrame::set(std::size_t paddle, Input::Key key, bool value) {
+    if (value)
+        paddles[paddle] |= static_cast<std::uint8_t>(1 << key);
+    else
+        paddles[paddle] &= static_cast<std::uint8_t>(~(1 << key));
+}
+bool my::InputFrame::get(std::size_t paddle, Input::Key key) const {
+    return (paddles[paddle] >> key) & 1;
+}
+
+my::Simulation::Simulation(const sf::FloatRect& screen, unsigned seed) :
+    rand{ seed }, grid{ screen, 100.f }, screen{ screen },
+    paddles{ {
+        Paddle{ { screen.width / 40.f, screen.height / 5.f }, { screen.width / 40.f, screen.height / 2 }, 0 },
+        Paddle{ { screen.width / 40.f, screen.height / 5.f }, { screen.width - screen.width / 40.f, screen.height / 2 }, 0 }
+    } },
+    balls{ 25.f },
+    walls{ {
+        Wall{ { screen.width, screen.height / 50.f }, { screen.width / 2, 0 } },
+        Wall{ { screen.width, screen.height / 50.f }, { screen.width / 2, screen.height } }
+    } },
+    ticks{ 0 }, pairsTested{ 0 } {
+    for (const auto& wall : walls)
+        statics.add(wall);
+    statics.update();
+    addBall();
+}
+void my::Simulation::addBall() {
+    bool right = rand() % 2, down = rand() % 2;
+    balls.add({ screen.width / 2, screen.height / 2 }, { 0, 0 }, right, down);
+}
+void my::Simulation::reset(std::size_t ball) {
+    balls.dx[ball] = rand() % 2 ? 1.f : -1.f;
+    balls.dy[ball] = rand() % 2 ? 1.f : -1.f;
+    balls.vx[ball] = 0;
+    balls.vy[ball] = 0;
+    balls.x[ball] = screen.width / 2;
+    balls.y[ball] = screen.height / 2;
+}
+void my::Simulation::rebuild() {
+    colliders.clear();
+    for (std::size_t i = 0; i < statics.size(); ++i)
+        colliders.push_back(statics.getBounds(i));
+    for (const auto& paddle : paddles)
+        colliders.push_back(paddle.getGlobalBounds());
+    grid.clear();
+    for (std::size_t id = 0; id < colliders.size(); ++id)
+        grid.insert(id, colliders[id]);
+}
+void my::Simulation::step(const InputFrame& input, float delta) {
+    //Update player movements: based on input frame, undo any move into a wall.
+    for (std::size_t i = 0; i < paddles.size(); ++i) {
+        for (int key = Input::Up; key < Input::Size; ++key) {
+            if (!input.get(i, static_cast<Input::Key>(key)))
+                continue;
+            paddles[i].move(static_cast<Input::Key>(key), delta);
+            for (std::size_t w = 0; w < statics.size(); ++w) {
+                if (paddles[i].getGlobalBounds().intersects(statics.getBounds(w))) {
+                    paddles[i].move(static_cast<Input::Key>(key), -delta);
+                }
+            }
+        }
+    }
+    //Bucket this tick's collider bounds once; balls only query the grid.
+    statics.update();
+    rebuild();
+    pairsTested = 0;
+
+    //Check ball to screen collision state: if outside, set to center and reset.
+    for (std::size_t i = 0; i < balls.size(); ++i) {
+        if (!balls.getBounds(i).intersects(screen)) {
+            if (balls.x[i] > screen.width / 2)
+                ++paddles[0].score;
+            else
+                ++paddles[1].score;
+            reset(i);
+        }
+    }
+
+    //Accumulate velocity and update position of every ball:
+    balls.integrate(delta, maxSpeed);
+
+    //Sweep each ball's motion of this tick against nearby walls and paddles. A hit moves
+    //the ball to the contact, reflects it and spends the rest of the motion in one step.
+    for (std::size_t i = 0; i < balls.size(); ++i) {
+        sf::Vector2f velocity{ balls.vx[i], balls.vy[i] },
+                     motion{ velocity },
+                     end{ balls.getCenter(i) },
+                     start{ end - motion };
+        sf::FloatRect before = balls.getBounds(i), after = before;
+        before.left -= motion.x;
+        before.top -= motion.y;
+        sf::FloatRect swept{ std::min(before.left, after.left), std::min(before.top, after.top),
+                             std::abs(motion.x) + after.width, std::abs(motion.y) + after.height };
+
+        //Only test the walls and paddles sharing a grid cell with the swept ball.
+        candidates.clear();
+        grid.query(swept, candidates);
+        bool hit = false;
+        for (std::size_t id : candidates) {
+            ++pairsTested;
+            Sweep contact = sweep(start, balls.radius, motion, colliders[id]);
+            if (!contact.hit)
+                continue;
+            hit = true;
+            motion = reflect(contact, start, velocity, motion);
+            end = start;
+            start -= motion;
+            //Reverse direction away from the surface that was hit.
+            if (contact.normal.x)
+                balls.dx[i] = contact.normal.x > 0 ? 1.f : -1.f;
+            if (contact.normal.y)
+                balls.dy[i] = contact.normal.y > 0 ? 1.f : -1.f;
+        }
+        if (hit) {
+            balls.vx[i] = velocity.x;
+            balls.vy[i] = velocity.y;
+            balls.setCenter(i, end);
+        }
+    }
+    ++ticks;
+}
+
+std::uint64_t my::Simulation::checksum() const {
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, std::size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    for (auto array : { &balls.x, &balls.y, &balls.vx, &balls.vy, &balls.dx, &balls.dy })
+        mix(array->data(), array->size() * sizeof(float));
+    for (const auto& paddle : paddles) {
+        sf::Vector2f position = paddle.getPosition();
+        std::uint64_t score = paddle.score;
+        mix(&position.x, sizeof position.x);
+        mix(&position.y, sizeof position.y);
+        mix(&score, sizeof score);
+    }
+    std::uint64_t tick = ticks;
+    mix(&tick, sizeof tick);
+    return hash;
+}
+
+my::InputFrame my::autopilot(const Simulation& simulation) {
+    InputFrame frame;
+    for (std::size_t i = 0; i < simulation.paddles.size(); ++i) {
+        const Paddle& paddle = simulation.paddles[i];
+        const BallStore& balls = simulation.balls;
+        std::size_t target = balls.size();
+        float distance = 0;
+        for (std::size_t j = 0; j < balls.size(); ++j) {
+            //Left paddle chases balls moving left, right paddle balls moving right.
+            if ((balls.dx[j] > 0) == (i == 0))
+                continue;
+            float d = std::abs(balls.x[j] - paddle.getPosition().x);
+            if (target == balls.size() || d < distance) {
+                target = j;
+                distance = d;
+            }
+        }
+        if (target == balls.size())
+            continue;
+        float dy = balls.y[target] - paddle.getPosition().y;
+        if (std::abs(dy) > paddle.getSize().y / 4)
+            frame.set(i, dy < 0 ? Input::Up : Input::Down, true);
+    }
+    return frame;
+}
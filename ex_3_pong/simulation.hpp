@@ -0,0 +1,58 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+/*
+    Description: Window-free Pong simulation. Owns the paddles, balls and walls and
+        advances them one fixed tick at a time from an InputFrame instead of reading
+        the keyboard, so it can be driven by a player, a script or a recording.
+*/
+#include "shapes.hpp"
+#include "ballstore.hpp"
+#include "broadphase.hpp"
+#include "staticgeometry.hpp"
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace my {
+    //Input state of a single tick: one bit per Input::Key for each paddle.
+    struct InputFrame {
+        std::array<std::uint8_t, 2> paddles{};
+        void set(std::size_t paddle, Input::Key key, bool value);
+        bool get(std::size_t paddle, Input::Key key) const;
+    };
+
+    class Simulation {
+    private:
+        std::mt19937 rand;
+        UniformGrid grid;
+        //Collider bounds of this tick: walls first, then paddles.
+        std::vector<sf::FloatRect> colliders;
+        std::vector<std::size_t> candidates;
+        void reset(std::size_t ball);
+        void rebuild();
+    public:
+        sf::FloatRect screen;
+        std::array<Paddle, 2> paddles;
+        BallStore balls;
+        std::array<Wall, 2> walls;
+        //Walls never move: bounds and vertices baked once. Holds pointers into walls.
+        StaticGeometry statics;
+        std::size_t ticks;
+        //Ball-vs-collider narrowphase tests made during the last step.
+        std::size_t pairsTested;
+        Simulation(const sf::FloatRect& screen, unsigned seed);
+        Simulation(const Simulation&) = delete;
+        Simulation& operator=(const Simulation&) = delete;
+        //Serve another ball from the center in a random direction.
+        void addBall();
+        //Advance the simulation by one tick of delta seconds.
+        void step(const InputFrame& input, float delta);
+        //FNV-1a hash of the exact bits of every ball, paddle and score, and the tick.
+        std::uint64_t checksum() const;
+    };
+
+    //Scripted input: each paddle follows the closest ball heading towards it.
+    InputFrame autopilot(const Simulation& simulation);
+}
+#endif // !SIMULATION_HPP
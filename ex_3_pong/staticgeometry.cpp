@@ -0,0 +1,70 @@
+#include "staticgeometry.hpp"
+
+my::StaticGeometry::StaticGeometry() :
+    changed{ false }, vertices{ sf::Triangles }, buffer{ sf::Triangles, sf::VertexBuffer::Static },
+    uploaded{ false }, rebuilds{ 0 } {}
+std::size_t my::StaticGeometry::add(const sf::Shape& shape) {
+    shapes.push_back(&shape);
+    bounds.push_back(sf::FloatRect{});
+    dirty.push_back(true);
+    changed = true;
+    return shapes.size() - 1;
+}
+void my::StaticGeometry::markDirty(std::size_t index) {
+    dirty[index] = true;
+    changed = true;
+}
+void my::StaticGeometry::update() {
+    if (!changed)
+        return;
+    for (std::size_t i = 0; i < shapes.size(); ++i)
+        if (dirty[i]) {
+            bounds[i] = shapes[i]->getGlobalBounds();
+            dirty[i] = false;
+        }
+    bake();
+    changed = false;
+    uploaded = false;
+    ++rebuilds;
+}
+void my::StaticGeometry::bake() {
+    //Shapes are convex: fan each one out from its first point.
+    vertices.clear();
+    for (const sf::Shape* shape : shapes) {
+        const sf::Transform& transform = shape->getTransform();
+        const sf::Color& color = shape->getFillColor();
+        std::size_t count = shape->getPointCount();
+        if (count < 3)
+            continue;
+        sf::Vector2f first = transform.transformPoint(shape->getPoint(0));
+        for (std::size_t k = 1; k + 1 < count; ++k) {
+            vertices.append(sf::Vertex{ first, color });
+            vertices.append(sf::Vertex{ transform.transformPoint(shape->getPoint(k)), color });
+            vertices.append(sf::Vertex{ transform.transformPoint(shape->getPoint(k + 1)), color });
+        }
+    }
+}
+const sf::FloatRect& my::StaticGeometry::getBounds(std::size_t index) const {
+    return bounds[index];
+}
+std::size_t my::StaticGeometry::size() const {
+    return shapes.size();
+}
+std::size_t my::StaticGeometry::getVertexCount() const {
+    return vertices.getVertexCount();
+}
+// Inherited via Drawable
+void my::StaticGeometry::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (!vertices.getVertexCount())
+        return;
+    if (!sf::VertexBuffer::isAvailable()) {
+        target.draw(vertices, states);
+        return;
+    }
+    if (!uploaded) {
+        buffer.create(vertices.getVertexCount());
+        buffer.update(&vertices[0]);
+        uploaded = true;
+    }
+    target.draw(buffer, states);
+}
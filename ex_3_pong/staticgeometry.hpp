@@ -0,0 +1,43 @@
+#ifndef STATICGEOMETRY_HPP
+#define STATICGEOMETRY_HPP
+/*
+    Description: Cache for shapes that do not move. Each shape's world bounds are computed
+        once and its fill is baked, already transformed, into one shared triangle list that
+        is drawn with a single call (uploaded once to a vertex buffer where supported).
+        Nothing is recomputed until a shape is marked dirty: call markDirty after changing
+        a shape's transform, size or color, then update before reading bounds again.
+        Outlines are not baked.
+*/
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace my {
+    class StaticGeometry : public sf::Drawable {
+    private:
+        std::vector<const sf::Shape*> shapes;
+        std::vector<sf::FloatRect> bounds;
+        std::vector<bool> dirty;
+        bool changed;
+        sf::VertexArray vertices;
+        //Uploaded lazily by the drawing thread, again only after a re-bake.
+        mutable sf::VertexBuffer buffer;
+        mutable bool uploaded;
+        void bake();
+    public:
+        //Times update found dirty shapes and re-baked.
+        std::size_t rebuilds;
+        StaticGeometry();
+        //The shape must outlive the cache; returns its index for getBounds and markDirty.
+        std::size_t add(const sf::Shape& shape);
+        void markDirty(std::size_t index);
+        //Recompute bounds of dirty shapes and re-bake the vertices; nothing when clean.
+        void update();
+        const sf::FloatRect& getBounds(std::size_t index) const;
+        std::size_t size() const;
+        std::size_t getVertexCount() const;
+        // Inherited via Drawable
+        void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    };
+}
+#endif // !STATICGEOMETRY_HPP
@@ -1,17 +1,216 @@
 #include "assetmanager.hpp"
 
-std::unordered_map<std::string, std::shared_ptr<sf::Texture>> my::AssetManager::assets;
+std::unordered_map<std::string, my::AssetManager::Asset> my::AssetManager::assets;
+std::list<std::string> my::AssetManager::recent;
+my::AssetManager::Stats my::AssetManager::stats{ 0, 0, 0, 0, 0, 0 };
+my::Atlas my::AssetManager::atlas;
+std::unordered_map<std::string, std::shared_ptr<my::AssetManager::Request>> my::AssetManager::requests;
+std::deque<std::shared_ptr<my::AssetManager::Request>> my::AssetManager::queued, my::AssetManager::decoded;
+std::vector<std::thread> my::AssetManager::workers;
+std::mutex my::AssetManager::mutex;
+std::condition_variable my::AssetManager::signal;
+std::condition_variable my::AssetManager::decoding;
+bool my::AssetManager::stopping = false;
+
+namespace {
+    //Joins the decode pool before the static members above are destroyed.
+    struct PoolGuard {
+        ~PoolGuard() { my::AssetManager::stop(); }
+    } pool_guard;
+}
+
 bool my::AssetManager::file_exists(std::string filename) {
     std::fstream file(filename, std::fstream::in);//fstream implements RAII
     return file.good();
 }
 std::shared_ptr<sf::Texture> my::AssetManager::load(std::string filename) {
-    if (file_exists(filename)) {
-        if (assets.find(filename) == assets.end()) {
-            assets[filename] = std::make_shared<sf::Texture>();
-            assets[filename]->loadFromFile(filename);
+    //Already in flight: finish that load instead of decoding twice. A hit, as in loadAsync.
+    auto request = requests.find(filename);
+    if (request != requests.end()) {
+        ++stats.hits;
+        Handle handle = request->second->handle;
+        while (!ready(handle)) {
+            {
+                std::unique_lock<std::mutex> lock{ mutex };
+                decoding.wait(lock, [] { return !decoded.empty(); });
+            }
+            update();
         }
-        return assets[filename];
+        return handle.get();
+    }
+    auto asset = assets.find(filename);
+    if (asset != assets.end())
+        return touch(asset->second);
+    if (file_exists(filename)) {
+        ++stats.misses;
+        auto texture = std::make_shared<sf::Texture>();
+        texture->loadFromFile(filename);
+        insert(filename, texture);
+        return texture;
     }
     return 0;
-}
\ No newline at end of file
+}
+my::AssetManager::Handle my::AssetManager::loadAsync(std::string filename) {
+    auto asset = assets.find(filename);
+    if (asset != assets.end()) {
+        std::promise<std::shared_ptr<sf::Texture>> promise;
+        promise.set_value(touch(asset->second));
+        return promise.get_future().share();
+    }
+    auto it = requests.find(filename);
+    if (it != requests.end()) {
+        ++stats.hits;
+        return it->second->handle;
+    }
+    ++stats.misses;
+
+    if (workers.empty())
+        start();
+    auto request = std::make_shared<Request>();
+    request->filename = filename;
+    request->loaded = false;
+    request->handle = request->promise.get_future().share();
+    requests[filename] = request;
+    {
+        std::lock_guard<std::mutex> lock{ mutex };
+        queued.push_back(request);
+    }
+    signal.notify_one();
+    return request->handle;
+}
+bool my::AssetManager::ready(const Handle& handle) {
+    return handle.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+void my::AssetManager::work() {
+    for (;;) {
+        std::shared_ptr<Request> request;
+        {
+            std::unique_lock<std::mutex> lock{ mutex };
+            signal.wait(lock, [] { return stopping || !queued.empty(); });
+            if (stopping)
+                return;
+            request = queued.front();
+            queued.pop_front();
+        }
+        //Decode off the main thread; only the upload needs the GL context.
+        bool loaded = request->image.loadFromFile(request->filename);
+        {
+            std::lock_guard<std::mutex> lock{ mutex };
+            request->loaded = loaded;
+            decoded.push_back(request);
+        }
+        decoding.notify_all();
+    }
+}
+void my::AssetManager::upload(Request& request) {
+    std::shared_ptr<sf::Texture> texture;
+    if (request.loaded) {
+        texture = std::make_shared<sf::Texture>();
+        if (texture->loadFromImage(request.image))
+            insert(request.filename, texture);
+        else
+            texture = 0;
+    }
+    requests.erase(request.filename);
+    request.image = sf::Image{};
+    request.promise.set_value(texture);
+}
+std::size_t my::AssetManager::update(std::size_t limit) {
+    std::deque<std::shared_ptr<Request>> ready;
+    {
+        std::lock_guard<std::mutex> lock{ mutex };
+        while (!decoded.empty() && (!limit || ready.size() < limit)) {
+            ready.push_back(decoded.front());
+            decoded.pop_front();
+        }
+    }
+    for (auto& request : ready)
+        upload(*request);
+    //Textures released since the last frame are freed here, not only when another loads.
+    trim();
+    return ready.size();
+}
+void my::AssetManager::start(unsigned threads) {
+    if (!workers.empty())
+        return;
+    if (!threads) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        threads = hardware > 1 ? hardware - 1 : 1;
+    }
+    stopping = false;
+    for (unsigned i = 0; i < threads; ++i)
+        workers.emplace_back(work);
+}
+void my::AssetManager::stop() {
+    std::deque<std::shared_ptr<Request>> dropped;
+    {
+        std::lock_guard<std::mutex> lock{ mutex };
+        stopping = true;
+        dropped.swap(queued);
+    }
+    signal.notify_all();
+    for (auto& worker : workers)
+        worker.join();
+    workers.clear();
+    //Never decoded: resolve to null so nobody waits on them forever.
+    for (auto& request : dropped) {
+        requests.erase(request->filename);
+        request->promise.set_value(0);
+    }
+}
+std::shared_ptr<sf::Texture> my::AssetManager::touch(Asset& asset) {
+    ++stats.hits;
+    recent.splice(recent.begin(), recent, asset.recent);
+    return asset.texture;
+}
+void my::AssetManager::insert(const std::string& filename, std::shared_ptr<sf::Texture> texture) {
+    sf::Vector2u size = texture->getSize();
+    std::size_t bytes = static_cast<std::size_t>(size.x) * size.y * 4;//RGBA8
+    recent.push_front(filename);
+    assets[filename] = Asset{ texture, bytes, recent.begin() };
+    stats.residentBytes += bytes;
+    stats.textures = assets.size();
+    trim();
+}
+void my::AssetManager::setBudget(std::size_t bytes) {
+    stats.budget = bytes;
+    trim();
+}
+std::size_t my::AssetManager::trim() {
+    std::size_t evicted = 0;
+    auto it = recent.end();
+    while (stats.budget && stats.residentBytes > stats.budget && it != recent.begin()) {
+        --it;
+        Asset& asset = assets[*it];
+        //Still held by an entity (or a caller): skip, it can not be freed yet.
+        if (asset.texture.use_count() > 1)
+            continue;
+        stats.residentBytes -= asset.bytes;
+        assets.erase(*it);
+        it = recent.erase(it);
+        ++evicted;
+    }
+    stats.evictions += evicted;
+    stats.textures = assets.size();
+    return evicted;
+}
+const my::AssetManager::Stats& my::AssetManager::getStats() {
+    return stats;
+}
+void my::AssetManager::pack(const std::vector<std::string>& filenames) {
+    for (const auto& filename : filenames)
+        if (!atlas.contains(filename))
+            atlas.add(filename);
+    atlas.build();
+}
+my::TextureRegion my::AssetManager::loadRegion(std::string filename) {
+    if (atlas.contains(filename)) {
+        ++stats.hits;
+        return atlas.get(filename);
+    }
+    std::shared_ptr<sf::Texture> texture = load(filename);
+    if (!texture)
+        return TextureRegion{ 0, sf::IntRect{} };
+    return TextureRegion{ texture, sf::IntRect{ 0, 0, static_cast<int>(texture->getSize().x),
+                                                static_cast<int>(texture->getSize().y) } };
+}
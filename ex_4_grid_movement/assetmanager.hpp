@@ -2,20 +2,90 @@
 #define ASSETMANAGER_HPP
 /*
     Description: Pure static class asset manager. Manages assets.
+        Textures can be loaded synchronously with load, or asynchronously with loadAsync:
+        files are decoded to sf::Image on worker threads and uploaded to the GPU on the
+        main thread by update, which the game loop calls once per frame.
+        Cached textures are kept under an optional memory budget: once resident bytes
+        exceed it, textures no one else holds are evicted least recently used first,
+        on the next load or update.
+        Every function is meant to be called from the main thread.
 */
 
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Image.hpp>
 #include <memory>
 #include <unordered_map>
 #include <fstream>
+#include <future>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <list>
+#include "atlas.hpp"
 namespace my {
     class AssetManager {
+    public:
+        //Resolves to the texture (or null when the file can not be loaded) once uploaded.
+        typedef std::shared_future<std::shared_ptr<sf::Texture>> Handle;
+        struct Stats {
+            std::size_t budget, residentBytes, textures, hits, misses, evictions;
+        };
     private:
-        static std::unordered_map<std::string, std::shared_ptr<sf::Texture>> assets;
+        struct Asset {
+            std::shared_ptr<sf::Texture> texture;
+            std::size_t bytes;
+            std::list<std::string>::iterator recent;
+        };
+        //A texture in flight: decoded by a worker, uploaded by update.
+        struct Request {
+            std::string filename;
+            sf::Image image;
+            bool loaded;
+            std::promise<std::shared_ptr<sf::Texture>> promise;
+            Handle handle;
+        };
+        static std::unordered_map<std::string, Asset> assets;
+        //Keys from most to least recently used.
+        static std::list<std::string> recent;
+        static Stats stats;
+        static Atlas atlas;
+        static std::unordered_map<std::string, std::shared_ptr<Request>> requests;
+        static std::deque<std::shared_ptr<Request>> queued, decoded;
+        static std::vector<std::thread> workers;
+        static std::mutex mutex;
+        static std::condition_variable signal;  //Work queued, or stopping.
+        static std::condition_variable decoding;//An image joined decoded.
+        static bool stopping;
         static bool file_exists(std::string filename);
+        static void work();
+        static void upload(Request& request);
+        static std::shared_ptr<sf::Texture> touch(Asset& asset);
+        static void insert(const std::string& filename, std::shared_ptr<sf::Texture> texture);
     public:
         //Returns a copy of shared pointer to texture by value: RVO > unsafe
         static std::shared_ptr<sf::Texture> load(std::string filename);
+        //Queues filename for decoding; repeat requests share the same in-flight load.
+        static Handle loadAsync(std::string filename);
+        static bool ready(const Handle& handle);
+        //Uploads up to limit decoded images (0: all), returns the number uploaded.
+        //Then trims, so textures released by destroyed entities leave within a frame.
+        static std::size_t update(std::size_t limit = 0);
+        //Starts the decode pool, threads = 0 picks one less than the hardware threads.
+        static void start(unsigned threads = 0);
+        //Stops and joins the decode pool, dropping queued requests.
+        static void stop();
+        //Resident texture budget in bytes, 0 for unlimited. Trims immediately.
+        static void setBudget(std::size_t bytes);
+        //Evicts unreferenced textures, least recently used first, until within budget.
+        //Returns the number evicted. update calls it every frame.
+        static std::size_t trim();
+        static const Stats& getStats();
+        //Packs the files into the shared atlas so their sprites share texture binds.
+        static void pack(const std::vector<std::string>& filenames);
+        //Region of filename in the atlas, or the whole of its own texture if not packed.
+        static TextureRegion loadRegion(std::string filename);
     };
 }
 #endif // !ASSETMANAGER_HPP
@@ -0,0 +1,122 @@
+#include "atlas.hpp"
+#include <algorithm>
+#include <limits>
+
+my::Atlas::Atlas(unsigned size, unsigned padding) : size{ size }, padding{ padding }, clamped{ false } {}
+//Asking for the maximum size creates a GL context: done here, not before main.
+void my::Atlas::clamp() {
+    if (clamped)
+        return;
+    size = std::min(size, sf::Texture::getMaximumSize());
+    clamped = true;
+}
+bool my::Atlas::add(const std::string& key, const sf::Image& image) {
+    clamp();
+    sf::Vector2u extent = image.getSize();
+    if (extent.x + padding > size || extent.y + padding > size)
+        return false;
+    pending.emplace_back(key, image);
+    return true;
+}
+bool my::Atlas::add(const std::string& filename) {
+    sf::Image image;
+    return image.loadFromFile(filename) && add(filename, image);
+}
+//Height the rect would rest at if its left edge sat on skyline node, false if it spills.
+bool my::Atlas::fit(const Page& page, std::size_t node, int width, int height, int size, int& y) {
+    int x = page.skyline[node].x;
+    if (x + width > size)
+        return false;
+    y = 0;
+    for (std::size_t i = node; width > 0; ++i) {
+        y = std::max(y, page.skyline[i].y);
+        if (y + height > size)
+            return false;
+        width -= page.skyline[i].width;
+    }
+    return true;
+}
+void my::Atlas::place(Page& page, std::size_t node, const sf::IntRect& rect) {
+    std::vector<Node>& skyline = page.skyline;
+    skyline.insert(skyline.begin() + node, Node{ rect.left, rect.top + rect.height, rect.width });
+    //Shrink or drop the nodes now covered by the new one.
+    for (std::size_t i = node + 1; i < skyline.size(); ) {
+        int covered = skyline[i - 1].x + skyline[i - 1].width - skyline[i].x;
+        if (covered <= 0)
+            break;
+        skyline[i].x += covered;
+        skyline[i].width -= covered;
+        if (skyline[i].width > 0)
+            break;
+        skyline.erase(skyline.begin() + i);
+    }
+    //Merge neighbours at the same height.
+    for (std::size_t i = 0; i + 1 < skyline.size(); ) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+            ++i;
+    }
+}
+bool my::Atlas::pack(Page& page, int width, int height, sf::IntRect& rect) const {
+    std::size_t best = page.skyline.size();
+    int best_y = std::numeric_limits<int>::max(), best_width = best_y;
+    for (std::size_t i = 0; i < page.skyline.size(); ++i) {
+        int y;
+        if (!fit(page, i, width, height, static_cast<int>(size), y))
+            continue;
+        //Lowest top first, then the narrowest node to limit wasted space.
+        if (y < best_y || (y == best_y && page.skyline[i].width < best_width)) {
+            best = i;
+            best_y = y;
+            best_width = page.skyline[i].width;
+        }
+    }
+    if (best == page.skyline.size())
+        return false;
+    rect = sf::IntRect{ page.skyline[best].x, best_y, width, height };
+    place(page, best, rect);
+    return true;
+}
+void my::Atlas::build() {
+    clamp();
+    std::stable_sort(pending.begin(), pending.end(), [](const std::pair<std::string, sf::Image>& a,
+                                                        const std::pair<std::string, sf::Image>& b) {
+        return a.second.getSize().y > b.second.getSize().y;
+    });
+    std::vector<bool> dirty(pages.size(), false);
+    for (const auto& entry : pending) {
+        sf::Vector2u extent = entry.second.getSize();
+        int width = static_cast<int>(extent.x + padding), height = static_cast<int>(extent.y + padding);
+        sf::IntRect rect;
+        std::size_t page = 0;
+        while (page < pages.size() && !pack(pages[page], width, height, rect))
+            ++page;
+        if (page == pages.size()) {
+            pages.push_back(Page{ { Node{ 0, 0, static_cast<int>(size) } }, sf::Image{}, std::make_shared<sf::Texture>() });
+            pages.back().image.create(size, size, sf::Color::Transparent);
+            dirty.push_back(false);
+            pack(pages.back(), width, height, rect);
+        }
+        pages[page].image.copy(entry.second, rect.left, rect.top);
+        dirty[page] = true;
+        regions[entry.first] = TextureRegion{ pages[page].texture,
+                                              sf::IntRect{ rect.left, rect.top, static_cast<int>(extent.x), static_cast<int>(extent.y) } };
+    }
+    pending.clear();
+    for (std::size_t page = 0; page < pages.size(); ++page)
+        if (dirty[page])
+            pages[page].texture->loadFromImage(pages[page].image);
+}
+bool my::Atlas::contains(const std::string& key) const {
+    return regions.find(key) != regions.end();
+}
+my::TextureRegion my::Atlas::get(const std::string& key) const {
+    auto it = regions.find(key);
+    return it != regions.end() ? it->second : TextureRegion{ 0, sf::IntRect{} };
+}
+std::size_t my::Atlas::getPageCount() const {
+    return pages.size();
+}
@@ -0,0 +1,55 @@
+#ifndef ATLAS_HPP
+#define ATLAS_HPP
+/*
+    Description: Texture atlas. Images are packed into one or more large pages with a
+        skyline (bottom-left) packer so sprites sharing a page share a texture bind.
+        A TextureRegion is the lightweight handle: the page and the sub-rectangle.
+*/
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace my {
+    struct TextureRegion {
+        std::shared_ptr<sf::Texture> texture;
+        sf::IntRect rect;
+    };
+
+    class Atlas {
+    private:
+        struct Node {
+            int x, y, width;
+        };
+        //Skyline of one page: the top edge of everything packed so far, left to right.
+        struct Page {
+            std::vector<Node> skyline;
+            sf::Image image;
+            std::shared_ptr<sf::Texture> texture;
+        };
+        unsigned size, padding;
+        bool clamped;//size is cut to what the GPU supports on first use, not at construction.
+        std::vector<Page> pages;
+        std::vector<std::pair<std::string, sf::Image>> pending;
+        std::unordered_map<std::string, TextureRegion> regions;
+        static bool fit(const Page& page, std::size_t node, int width, int height, int size, int& y);
+        static void place(Page& page, std::size_t node, const sf::IntRect& rect);
+        bool pack(Page& page, int width, int height, sf::IntRect& rect) const;
+        void clamp();
+    public:
+        //Needs no GL context, so an atlas may be a static.
+        Atlas(unsigned size = 2048, unsigned padding = 1);
+        //Queue an image for the next build; returns false when it can never fit a page.
+        bool add(const std::string& key, const sf::Image& image);
+        bool add(const std::string& filename);
+        //Pack queued images (tallest first) and upload every page that changed.
+        void build();
+        bool contains(const std::string& key) const;
+        TextureRegion get(const std::string& key) const;
+        std::size_t getPageCount() const;
+    };
+}
+#endif // !ATLAS_HPP
@@ -0,0 +1,74 @@
+#include "batchrenderer.hpp"
+#include <cmath>
+#include <utility>
+
+void my::appendQuad(sf::VertexArray& vertices, const sf::Transform& transform, const sf::FloatRect& rect,
+                    const sf::Color& color, const sf::FloatRect& texture) {
+    float right = rect.left + rect.width, bottom = rect.top + rect.height,
+          u = texture.left + texture.width, v = texture.top + texture.height;
+    vertices.append(sf::Vertex{ transform.transformPoint({ rect.left, rect.top }), color, { texture.left, texture.top } });
+    vertices.append(sf::Vertex{ transform.transformPoint({ right, rect.top }), color, { u, texture.top } });
+    vertices.append(sf::Vertex{ transform.transformPoint({ right, bottom }), color, { u, v } });
+    vertices.append(sf::Vertex{ transform.transformPoint({ rect.left, bottom }), color, { texture.left, v } });
+}
+void my::appendOutline(sf::VertexArray& vertices, const sf::Transform& transform, const sf::Vector2f& size,
+                       float thickness, const sf::Color& color) {
+    if (!thickness)
+        return;
+    float t = std::abs(thickness), grow = thickness > 0 ? t : 0;
+    sf::FloatRect outer{ -grow, -grow, size.x + grow * 2, size.y + grow * 2 };
+    appendQuad(vertices, transform, { outer.left, outer.top, outer.width, t }, color);
+    appendQuad(vertices, transform, { outer.left, outer.top + outer.height - t, outer.width, t }, color);
+    appendQuad(vertices, transform, { outer.left, outer.top + t, t, outer.height - t * 2 }, color);
+    appendQuad(vertices, transform, { outer.left + outer.width - t, outer.top + t, t, outer.height - t * 2 }, color);
+}
+
+my::BatchRenderer::BatchRenderer() : drawCalls{ 0 }, vertexCount{ 0 } {}
+void my::BatchRenderer::clear() {
+    //A batch nothing was added to since the last clear belongs to a texture that is gone
+    //or unused: drop it, or evicted and reloaded textures would add batches forever.
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < batches.size(); ++i) {
+        if (!batches[i].vertices.getVertexCount()) {
+            lookup.erase(batches[i].texture);
+            continue;
+        }
+        batches[i].vertices.clear();
+        if (kept != i) {
+            batches[kept] = std::move(batches[i]);
+            lookup[batches[kept].texture] = kept;
+        }
+        ++kept;
+    }
+    batches.erase(batches.begin() + kept, batches.end());
+}
+sf::VertexArray& my::BatchRenderer::batch(const sf::Texture* texture) {
+    auto it = lookup.find(texture);
+    if (it != lookup.end())
+        return batches[it->second].vertices;
+    lookup[texture] = batches.size();
+    batches.push_back(Batch{ texture, sf::VertexArray{ sf::Quads } });
+    return batches.back().vertices;
+}
+void my::BatchRenderer::add(const Entity& entity) {
+    entity.append(batch(entity.getTexture()));
+}
+std::size_t my::BatchRenderer::getBatchCount() const {
+    std::size_t count = 0;
+    for (const auto& batch : batches)
+        if (batch.vertices.getVertexCount())
+            ++count;
+    return count;
+}
+void my::BatchRenderer::draw(sf::RenderTarget& target, sf::RenderStates states) {
+    drawCalls = 0;
+    vertexCount = 0;
+    for (const auto& batch : batches) {
+        if (!batch.vertices.getVertexCount())
+            continue;
+        states.texture = batch.texture;
+        target.draw(batch.vertices, states);
+        ++drawCalls;
+        vertexCount += batch.vertices.getVertexCount();
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef BATCHRENDERER_HPP
+#define BATCHRENDERER_HPP
+/*
+    Description: Collects entity quads into one vertex array per texture each frame
+        and submits each array with a single draw call.
+*/
+#include <SFML/Graphics.hpp>
+#include <unordered_map>
+#include <vector>
+#include "entity.hpp"
+
+namespace my {
+    //Append rect transformed by transform as one quad, texture coordinates optional.
+    void appendQuad(sf::VertexArray& vertices, const sf::Transform& transform, const sf::FloatRect& rect,
+                    const sf::Color& color, const sf::FloatRect& texture = sf::FloatRect{});
+    //Outline of a size rectangle as four strips: outside when thickness is positive, inside when negative.
+    void appendOutline(sf::VertexArray& vertices, const sf::Transform& transform, const sf::Vector2f& size,
+                       float thickness, const sf::Color& color);
+
+    class BatchRenderer {
+    private:
+        struct Batch {
+            const sf::Texture* texture;
+            sf::VertexArray vertices;
+        };
+        //Batches persist between frames so their vertex storage is reused,
+        //until a frame passes without using them.
+        std::vector<Batch> batches;
+        std::unordered_map<const sf::Texture*, std::size_t> lookup;
+    public:
+        //Draw calls and vertices submitted by the last draw().
+        std::size_t drawCalls, vertexCount;
+        BatchRenderer();
+        //Start a new frame: empties every batch and drops those the last frame left empty.
+        void clear();
+        sf::VertexArray& batch(const sf::Texture* texture);
+        void add(const Entity& entity);
+        //Batches holding vertices: the texture binds the next draw will make.
+        std::size_t getBatchCount() const;
+        void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default);
+    };
+}
+#endif // !BATCHRENDERER_HPP
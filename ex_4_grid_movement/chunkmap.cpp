@@ -0,0 +1,342 @@
+#include "chunkmap.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <utility>
+
+const int my::Chunk::side;
+
+namespace {
+    const char magic[4] = { 'C', 'H', 'K', '1' };
+
+    void put(std::vector<char>& out, std::uint32_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i)
+            out.push_back(static_cast<char>(value >> (i * 8) & 0xFF));
+    }
+    //Reads bytes little-endian from data at at, false past the end.
+    bool get(const std::vector<char>& data, std::size_t& at, std::uint32_t& value, int bytes) {
+        if (at + bytes > data.size())
+            return false;
+        value = 0;
+        for (int i = 0; i < bytes; ++i)
+            value |= static_cast<std::uint32_t>(static_cast<unsigned char>(data[at + i])) << (i * 8);
+        at += bytes;
+        return true;
+    }
+    //Repeatable mix of a seed and two coordinates.
+    std::uint32_t hash(std::uint32_t seed, int x, int y) {
+        std::uint32_t h = seed ^ static_cast<std::uint32_t>(x) * 0x9E3779B1u ^ static_cast<std::uint32_t>(y) * 0x85EBCA77u;
+        h ^= h >> 15;
+        h *= 0x2C1B3C6Du;
+        h ^= h >> 12;
+        h *= 0x297A2D39u;
+        return h ^ h >> 15;
+    }
+}
+
+std::size_t my::Chunk::getBytes() const {
+    return sizeof(Chunk) + tiles.capacity() + residents.capacity() * sizeof(Resident);
+}
+
+my::ChunkMap::ChunkMap(int radius, std::size_t density, unsigned seed, std::string prefix) :
+    prefix{ prefix }, radius{ radius }, density{ density }, seed{ seed },
+    stats{ 0, 0, 0, 0, 0, 0, 0 }, stopping{ false }, worker{ &ChunkMap::work, this } {}
+my::ChunkMap::~ChunkMap() {
+    {
+        std::lock_guard<std::mutex> lock{ mutex };
+        //Loads no one will collect are dropped; saves and appends still go to disk.
+        for (auto it = requests.begin(); it != requests.end();)
+            it = it->job == Job::Load ? requests.erase(it) : std::next(it);
+        stopping = true;
+    }
+    signal.notify_all();
+    worker.join();
+}
+sf::Vector2i my::ChunkMap::chunkOf(const sf::Vector2i& cell) {
+    //Round toward negative infinity: cell -1 is in chunk -1, not 0.
+    auto floor = [](int a) { return a >= 0 ? a / Chunk::side : (a - Chunk::side + 1) / Chunk::side; };
+    return sf::Vector2i{ floor(cell.x), floor(cell.y) };
+}
+std::uint64_t my::ChunkMap::key(const sf::Vector2i& coordinate) {
+    return static_cast<std::uint64_t>(static_cast<std::uint32_t>(coordinate.x)) << 32 | static_cast<std::uint32_t>(coordinate.y);
+}
+void my::ChunkMap::enqueue(Job job, std::unique_ptr<Chunk> chunk) {
+    {
+        std::lock_guard<std::mutex> lock{ mutex };
+        requests.push_back(Request{ job, std::move(chunk) });
+    }
+    signal.notify_one();
+}
+void my::ChunkMap::work() {
+    for (;;) {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock{ mutex };
+            signal.wait(lock, [this] { return stopping || !requests.empty(); });
+            if (requests.empty())
+                return;
+            request = std::move(requests.front());
+            requests.pop_front();
+        }
+        Chunk& chunk = *request.chunk;
+        if (request.job == Job::Save) {
+            std::size_t bytes = write(chunk);
+            std::lock_guard<std::mutex> lock{ mutex };
+            ++stats.saves;
+            stats.diskBytes += bytes;
+            continue;
+        }
+        //Load and append both start from what is on disk, or a fresh chunk.
+        Chunk stored;
+        stored.coordinate = chunk.coordinate;
+        bool fresh = !read(stored);
+        if (fresh)
+            generate(stored);
+        std::size_t bytes = 0;
+        if (request.job == Job::Append) {
+            stored.residents.insert(stored.residents.end(), chunk.residents.begin(), chunk.residents.end());
+            bytes = write(stored);
+        }
+        std::lock_guard<std::mutex> lock{ mutex };
+        stats.generated += fresh;
+        stats.diskBytes += bytes;
+        if (request.job == Job::Load)
+            loaded.push_back(std::unique_ptr<Chunk>{ new Chunk(std::move(stored)) });
+    }
+}
+void my::ChunkMap::admit(World& world) {
+    std::deque<std::unique_ptr<Chunk>> ready;
+    {
+        std::lock_guard<std::mutex> lock{ mutex };
+        ready.swap(loaded);
+    }
+    float cell = world.getCell();
+    for (auto& chunk : ready) {
+        for (const Chunk::Resident& resident : chunk->residents) {
+            EntityId id = world.create({ resident.cell.x * cell, resident.cell.y * cell }, { cell, cell });
+            world.speeds[world.index(id)] = resident.speed;
+            world.renders[world.index(id)].fill = resident.fill;
+        }
+        //The world owns them now: the chunk keeps only its tiles.
+        chunk->residents.clear();
+        chunk->residents.shrink_to_fit();
+        std::uint64_t k = key(chunk->coordinate);
+        loading.erase(k);
+        stats.residentBytes += chunk->getBytes();
+        admitted.push_back(chunk->coordinate);
+        chunks[k] = std::move(chunk);
+        ++stats.loads;
+    }
+}
+void my::ChunkMap::update(World& world, const sf::Vector2f& center, EntityId player) {
+    admitted.clear();
+    evicted.clear();
+    admit(world);
+    float cell = world.getCell();
+    sf::Vector2i middle = chunkOf({ static_cast<int>(std::floor(center.x / cell)), static_cast<int>(std::floor(center.y / cell)) });
+    for (int y = -radius; y <= radius; ++y)
+        for (int x = -radius; x <= radius; ++x) {
+            sf::Vector2i coordinate{ middle.x + x, middle.y + y };
+            std::uint64_t k = key(coordinate);
+            if (chunks.count(k) || loading.count(k))
+                continue;
+            loading.insert(k);
+            std::unique_ptr<Chunk> chunk{ new Chunk };
+            chunk->coordinate = coordinate;
+            enqueue(Job::Load, std::move(chunk));
+        }
+    pageOut(world, player, middle, radius + 1);
+}
+void my::ChunkMap::save(World& world, EntityId player) {
+    admitted.clear();
+    evicted.clear();
+    while (!loading.empty()) {
+        admit(world);
+        std::this_thread::yield();
+    }
+    pageOut(world, player, {}, -1);
+}
+void my::ChunkMap::pageOut(World& world, EntityId player, const sf::Vector2i& middle, int keep) {
+    //Which chunks near middle stay, in a flat window instead of a hash lookup per entity.
+    enum State : std::uint8_t { Leave, Stay };
+    int side = keep >= 0 ? 2 * keep + 1 : 0;
+    std::vector<State> window(side * side, Leave);
+    auto slot = [&middle, keep, side](const sf::Vector2i& coordinate) {
+        int x = coordinate.x - middle.x + keep, y = coordinate.y - middle.y + keep;
+        return x >= 0 && y >= 0 && x < side && y < side ? y * side + x : -1;
+    };
+    std::unordered_map<std::uint64_t, std::unique_ptr<Chunk>> leaving;
+    for (auto it = chunks.begin(); it != chunks.end();) {
+        int at = slot(it->second->coordinate);
+        if (at >= 0) {
+            window[at] = Stay;
+            ++it;
+            continue;
+        }
+        stats.residentBytes -= it->second->getBytes();
+        //Admitted by this same update: layers never saw it, so it is neither.
+        auto fresh = std::find(admitted.begin(), admitted.end(), it->second->coordinate);
+        if (fresh != admitted.end())
+            admitted.erase(fresh);
+        else
+            evicted.push_back(it->second->coordinate);
+        leaving[it->first] = std::move(it->second);
+        it = chunks.erase(it);
+    }
+    for (std::uint64_t k : loading) {
+        sf::Vector2i coordinate{ static_cast<int>(static_cast<std::uint32_t>(k >> 32)), static_cast<int>(static_cast<std::uint32_t>(k)) };
+        int at = slot(coordinate);
+        if (at >= 0)
+            window[at] = Stay;
+    }
+
+    //Entities leave with the chunk of the cell they are headed for; a move in progress is dropped.
+    std::unordered_map<std::uint64_t, std::vector<Chunk::Resident>> strays;
+    for (std::size_t i = world.size(); i-- > 0;) {
+        EntityId id = world.id(i);
+        if (id == player)
+            continue;
+        sf::Vector2i cell = world.cells[i] + world.headings[i], coordinate = chunkOf(cell);
+        int at = slot(coordinate);
+        std::uint64_t k = key(coordinate);
+        //Loads in flight stay too: their chunk was read before these entities could be added to it.
+        if ((at >= 0 && window[at] == Stay) || (at < 0 && loading.count(k)))
+            continue;
+        Chunk::Resident resident{ cell, world.speeds[i], world.renders[i].fill };
+        auto chunk = leaving.find(k);
+        if (chunk != leaving.end())
+            chunk->second->residents.push_back(resident);
+        else
+            strays[k].push_back(resident);
+        world.destroy(id);
+    }
+    for (auto& chunk : leaving)
+        enqueue(Job::Save, std::move(chunk.second));
+    for (auto& stray : strays) {
+        std::unique_ptr<Chunk> chunk{ new Chunk };
+        chunk->coordinate = chunkOf(stray.second.front().cell);
+        chunk->residents = std::move(stray.second);
+        enqueue(Job::Append, std::move(chunk));
+    }
+}
+const my::Chunk* my::ChunkMap::find(const sf::Vector2i& coordinate) const {
+    auto it = chunks.find(key(coordinate));
+    return it != chunks.end() ? it->second.get() : nullptr;
+}
+const std::vector<sf::Vector2i>& my::ChunkMap::getAdmitted() const {
+    return admitted;
+}
+const std::vector<sf::Vector2i>& my::ChunkMap::getEvicted() const {
+    return evicted;
+}
+int my::ChunkMap::getTile(const sf::Vector2i& cell) const {
+    sf::Vector2i coordinate = chunkOf(cell);
+    const Chunk* chunk = find(coordinate);
+    if (!chunk)
+        return -1;
+    return chunk->tiles[(cell.y - coordinate.y * Chunk::side) * Chunk::side + (cell.x - coordinate.x * Chunk::side)];
+}
+bool my::ChunkMap::setTile(const sf::Vector2i& cell, std::uint8_t tile) {
+    sf::Vector2i coordinate = chunkOf(cell);
+    auto it = chunks.find(key(coordinate));
+    if (it == chunks.end())
+        return false;
+    it->second->tiles[(cell.y - coordinate.y * Chunk::side) * Chunk::side + (cell.x - coordinate.x * Chunk::side)] = tile;
+    return true;
+}
+my::ChunkMap::Stats my::ChunkMap::getStats() const {
+    std::lock_guard<std::mutex> lock{ mutex };
+    Stats copy = stats;
+    copy.resident = chunks.size();
+    copy.loading = loading.size();
+    return copy;
+}
+std::string my::ChunkMap::getPath(const sf::Vector2i& coordinate) const {
+    return prefix + std::to_string(coordinate.x) + "_" + std::to_string(coordinate.y) + ".chunk";
+}
+bool my::ChunkMap::read(Chunk& chunk) const {
+    std::ifstream file{ getPath(chunk.coordinate), std::ios::binary };
+    if (!file)
+        return false;
+    std::vector<char> data{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+    std::size_t at = 0;
+    std::uint32_t x, y, count, value;
+    if (data.size() < 4 || !std::equal(magic, magic + 4, data.begin()))
+        return false;
+    at = 4;
+    if (!get(data, at, x, 4) || !get(data, at, y, 4) ||
+        static_cast<int>(x) != chunk.coordinate.x || static_cast<int>(y) != chunk.coordinate.y || !get(data, at, count, 4))
+        return false;
+    chunk.tiles.clear();
+    chunk.tiles.reserve(Chunk::side * Chunk::side);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::uint32_t length;
+        if (!get(data, at, length, 2) || !get(data, at, value, 1) || chunk.tiles.size() + length > chunk.tiles.capacity())
+            return false;
+        chunk.tiles.insert(chunk.tiles.end(), length, static_cast<std::uint8_t>(value));
+    }
+    if (chunk.tiles.size() != static_cast<std::size_t>(Chunk::side * Chunk::side) || !get(data, at, count, 4))
+        return false;
+    chunk.residents.clear();
+    chunk.residents.reserve(count);
+    sf::Vector2i origin{ chunk.coordinate.x * Chunk::side, chunk.coordinate.y * Chunk::side };
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::uint32_t cx, cy, speed, fill;
+        if (!get(data, at, cx, 1) || !get(data, at, cy, 1) || !get(data, at, speed, 2) || !get(data, at, fill, 4))
+            return false;
+        chunk.residents.push_back(Chunk::Resident{ { origin.x + static_cast<int>(cx), origin.y + static_cast<int>(cy) },
+                                                   speed / 256.f, sf::Color{ fill } });
+    }
+    return true;
+}
+std::size_t my::ChunkMap::write(const Chunk& chunk) const {
+    std::vector<char> out{ magic, magic + 4 };
+    put(out, static_cast<std::uint32_t>(chunk.coordinate.x), 4);
+    put(out, static_cast<std::uint32_t>(chunk.coordinate.y), 4);
+    //Runs are counted as they are written, then patched in.
+    std::size_t runsAt = out.size();
+    put(out, 0, 4);
+    std::uint32_t runs = 0;
+    for (std::size_t i = 0; i < chunk.tiles.size();) {
+        std::size_t length = 1;
+        while (i + length < chunk.tiles.size() && chunk.tiles[i + length] == chunk.tiles[i] && length < 0xFFFF)
+            ++length;
+        put(out, static_cast<std::uint32_t>(length), 2);
+        put(out, chunk.tiles[i], 1);
+        i += length;
+        ++runs;
+    }
+    for (int i = 0; i < 4; ++i)
+        out[runsAt + i] = static_cast<char>(runs >> (i * 8) & 0xFF);
+    put(out, static_cast<std::uint32_t>(chunk.residents.size()), 4);
+    sf::Vector2i origin{ chunk.coordinate.x * Chunk::side, chunk.coordinate.y * Chunk::side };
+    for (const Chunk::Resident& resident : chunk.residents) {
+        put(out, static_cast<std::uint32_t>(resident.cell.x - origin.x), 1);
+        put(out, static_cast<std::uint32_t>(resident.cell.y - origin.y), 1);
+        float speed = std::round(resident.speed * 256);
+        put(out, static_cast<std::uint32_t>(speed < 0 ? 0 : speed > 0xFFFF ? 0xFFFF : speed), 2);
+        put(out, resident.fill.toInteger(), 4);
+    }
+    std::ofstream file{ getPath(chunk.coordinate), std::ios::binary | std::ios::trunc };
+    file.write(out.data(), out.size());
+    return file ? out.size() : 0;
+}
+void my::ChunkMap::generate(Chunk& chunk) const {
+    //Tiles in patches of 8 by 8 cells, so runs stay long and files small.
+    sf::Vector2i origin{ chunk.coordinate.x * Chunk::side, chunk.coordinate.y * Chunk::side };
+    chunk.tiles.resize(Chunk::side * Chunk::side);
+    for (int y = 0; y < Chunk::side; ++y)
+        for (int x = 0; x < Chunk::side; ++x)
+            chunk.tiles[y * Chunk::side + x] = static_cast<std::uint8_t>(hash(seed, (origin.x + x) >> 3, (origin.y + y) >> 3) % 4);
+    std::mt19937 random{ hash(seed + 1, chunk.coordinate.x, chunk.coordinate.y) };
+    std::uniform_int_distribution<int> place{ 0, Chunk::side - 1 };
+    std::uniform_real_distribution<float> spread{ 0.f, 1.f };
+    chunk.residents.clear();
+    for (std::size_t i = 0; i < density; ++i) {
+        sf::Vector2i cell{ origin.x + place(random), origin.y + place(random) };
+        std::uint32_t color = hash(seed + 2, cell.x, cell.y) | 0xFF;
+        chunk.residents.push_back(Chunk::Resident{ cell, 4 + spread(random) * 8, sf::Color{ color } });
+    }
+}
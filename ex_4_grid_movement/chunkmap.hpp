@@ -0,0 +1,120 @@
+#ifndef CHUNKMAP_HPP
+#define CHUNKMAP_HPP
+/*
+    Description: Streams an endless grid world in fixed-size chunks around a center cell.
+        Chunks within radius of the center are resident: their tiles are in memory and their
+        entities live in the World. Chunks beyond radius + 1 are paged out, entities and all,
+        to one small file each; the ring in between stops a chunk from bouncing in and out
+        while the player walks along its edge. Only resident entities are ever updated
+        or drawn, however large the map.
+        File reads, writes and first-time generation run on one I/O thread in request order,
+        so a chunk saved and then requested again always loads what was saved. update()
+        hands finished loads to the World on the calling thread: call it once per frame
+        from the thread that owns the World.
+
+    File format, little-endian:
+        "CHK1", int32 x, int32 y,
+        uint32 runs, runs * { uint16 length, uint8 tile }       tiles, row major, run-length coded
+        uint32 residents, residents * { uint8 x, uint8 y,       cell within the chunk
+                                        uint16 speed,           8.8 fixed point
+                                        uint32 fill }           RGBA
+*/
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "world.hpp"
+
+namespace my {
+    struct Chunk {
+        static const int side = 32;//Cells per side.
+        //An entity held by the chunk while it is paged out.
+        struct Resident {
+            sf::Vector2i cell;
+            float speed;
+            sf::Color fill;
+        };
+        sf::Vector2i coordinate;
+        std::vector<std::uint8_t> tiles;//side * side tile ids, row major.
+        std::vector<Resident> residents;
+        std::size_t getBytes() const;
+    };
+
+    class ChunkMap {
+    public:
+        struct Stats {
+            std::size_t resident, loading, residentBytes;
+            //Since start: chunks paged in, paged out, generated fresh, and bytes written.
+            std::size_t loads, saves, generated, diskBytes;
+        };
+    private:
+        //Append adds paged-out entities to a chunk that is not resident.
+        enum class Job { Load, Save, Append };
+        struct Request {
+            Job job;
+            std::unique_ptr<Chunk> chunk;
+        };
+        std::string prefix;
+        int radius;
+        std::size_t density;
+        unsigned seed;
+        std::unordered_map<std::uint64_t, std::unique_ptr<Chunk>> chunks;
+        std::unordered_set<std::uint64_t> loading;
+        std::vector<sf::Vector2i> admitted, evicted;
+        Stats stats;
+        //I/O thread and its queues.
+        std::deque<Request> requests;
+        std::deque<std::unique_ptr<Chunk>> loaded;
+        mutable std::mutex mutex;
+        std::condition_variable signal;
+        bool stopping;
+        std::thread worker;
+        void work();
+        void enqueue(Job job, std::unique_ptr<Chunk> chunk);
+        //Hands finished loads to the world: entities are created, the chunk becomes resident.
+        void admit(World& world);
+        //Pages out chunks farther than keep from middle (all of them when keep < 0),
+        //along with every entity not standing in a chunk that stays.
+        void pageOut(World& world, EntityId player, const sf::Vector2i& middle, int keep);
+        std::string getPath(const sf::Vector2i& coordinate) const;
+        //I/O thread only.
+        bool read(Chunk& chunk) const;
+        std::size_t write(const Chunk& chunk) const;
+        void generate(Chunk& chunk) const;
+    public:
+        //density entities are scattered over each chunk the first time it is generated.
+        //Files are named prefix + "x_y.chunk"; the seed makes generated chunks repeatable.
+        ChunkMap(int radius, std::size_t density, unsigned seed, std::string prefix = "chunk_");
+        //Writes every queued save before returning; call save() first to keep resident chunks.
+        ~ChunkMap();
+        ChunkMap(const ChunkMap&) = delete;
+        ChunkMap& operator=(const ChunkMap&) = delete;
+
+        static sf::Vector2i chunkOf(const sf::Vector2i& cell);
+        static std::uint64_t key(const sf::Vector2i& coordinate);
+
+        //Pages chunks around center (in pixels) in and out. The player entity is never paged out.
+        void update(World& world, const sf::Vector2f& center, EntityId player);
+        //Pages every chunk out, waiting for loads in flight first.
+        void save(World& world, EntityId player);
+        //Resident chunk, or null.
+        const Chunk* find(const sf::Vector2i& coordinate) const;
+        //Chunks paged in and out by the last update or save, for layers that mirror them.
+        //Admitted chunks are resident: one paged out again in the same update is in neither.
+        const std::vector<sf::Vector2i>& getAdmitted() const;
+        const std::vector<sf::Vector2i>& getEvicted() const;
+        //Tile at cell, -1 when its chunk is not resident.
+        int getTile(const sf::Vector2i& cell) const;
+        //Edits a resident chunk's tile; it is written out with the chunk. False when not resident.
+        bool setTile(const sf::Vector2i& cell, std::uint8_t tile);
+        Stats getStats() const;
+    };
+}
+#endif // !CHUNKMAP_HPP
@@ -1,12 +1,32 @@
 #include "entity.hpp"
+#include "batchrenderer.hpp"
 
 my::Entity::Entity(std::shared_ptr<sf::Texture> texture_ptr) : texture_ptr{ texture_ptr } {
     if (texture_ptr) {
         sprite.setTexture(*texture_ptr);
         rect.setSize(sf::Vector2f{ texture_ptr->getSize() });
     }
-    speed = 10;
-    move_percent = 1;
+}
+my::Entity::Entity(const TextureRegion& region) : Entity{} {
+    rect.setSize(sf::Vector2f{ static_cast<float>(region.rect.width), static_cast<float>(region.rect.height) });
+    setTexture(region);
+}
+void my::Entity::setTexture(const TextureRegion& region) {
+    texture_ptr = region.texture;
+    if (texture_ptr) {
+        sprite.setTexture(*texture_ptr);
+        sprite.setTextureRect(region.rect);
+        sprite.setPosition(rect.getPosition());
+        setSize(sf::Vector2f{ rect.getSize() });
+    }
+}
+void my::Entity::setTexture(std::shared_ptr<sf::Texture> texture_ptr) {
+    this->texture_ptr = texture_ptr;
+    if (texture_ptr) {
+        sprite.setTexture(*texture_ptr, true);
+        sprite.setPosition(rect.getPosition());
+        setSize(sf::Vector2f{ rect.getSize() });
+    }
 }
 const sf::Vector2f& my::Entity::getSize() {
     return rect.getSize();
@@ -16,7 +36,9 @@ void my::Entity::setSize(float x, float y) {
 }
 void my::Entity::setSize(const sf::Vector2f& size) {
     if (texture_ptr) {
-        sprite.setScale(size.x / texture_ptr->getSize().x, size.y / texture_ptr->getSize().y);
+        //Scale against the visible sub-rectangle: the whole texture unless it is an atlas region.
+        const sf::IntRect& region = sprite.getTextureRect();
+        sprite.setScale(size.x / region.width, size.y / region.height);
     }
     rect.setSize(size);
 }
@@ -41,66 +63,33 @@ float my::Entity::getOutlineThickness() {
 void my::Entity::setOutlineThickness(float thickness) {
     rect.setOutlineThickness(thickness);
 }
-void my::Entity::setPosition(float x, float y, bool fixed) {
+void my::Entity::setPosition(float x, float y) {
     if (texture_ptr) {
         sprite.setPosition(x, y);
     }
     rect.setPosition(x, y);
-    if (fixed)
-        old_position = rect.getPosition();
 }
-void my::Entity::setPosition(const sf::Vector2f position, bool fixed) {
+void my::Entity::setPosition(const sf::Vector2f position) {
     if (texture_ptr) {
         sprite.setPosition(position);
     }
     rect.setPosition(position);
-    if (fixed)
-        old_position = rect.getPosition();
 }
 const sf::Vector2f my::Entity::getPosition() {
     return rect.getPosition();
 }
-void my::Entity::setPositionBy(const sf::Vector2f& position, bool fixed) {
-    setPosition(getPosition() + position, fixed);
-}
-void my::Entity::setPositionBy(float x, float y, bool fixed) {
-    x = getPosition().x + x;
-    y = getPosition().y + y;
-    setPosition(x, y, fixed);
-}
-void my::Entity::move(const sf::Vector2f & position) {
-    target_move = position;
-    old_position = getPosition();
-}
-void my::Entity::move(float x, float y) {
-    target_move.x = x;
-    target_move.y = y;
-    old_position = getPosition();
-}
-void my::Entity::moveBy(const sf::Vector2f & position) {
-    target_move += position;
-    old_position = getPosition();
-}
-void my::Entity::moveBy(float x, float y) {
-    target_move.x += x;
-    target_move.y += y;
-    old_position = getPosition();
-}
-const sf::Vector2f my::Entity::moving() {
-    return static_cast<sf::Vector2f>(static_cast<sf::Vector2i>(target_move - old_position));
-}
-bool my::Entity::isMoving() {
-    sf::Vector2f d{ moving() };
-    return d.x || d.y;
-}
-void my::Entity::move(float delta) {
-    if (isMoving()) {
-        sf::Vector2f d{ moving() };
-        setPositionBy(d.x * delta, d.y * delta, false);
-        d = static_cast<sf::Vector2f>(static_cast<sf::Vector2i>(target_move - getPosition()));
-        if (!d.x && !d.y)
-            setPosition(target_move, true);
+const sf::Texture* my::Entity::getTexture() const {
+    return texture_ptr.get();
+}
+void my::Entity::append(sf::VertexArray & vertices) const {
+    if (texture_ptr) {
+        sf::FloatRect texture{ sprite.getTextureRect() };
+        appendQuad(vertices, sprite.getTransform(), { 0, 0, texture.width, texture.height }, sprite.getColor(), texture);
+        return;
     }
+    sf::Vector2f size{ rect.getSize() };
+    appendQuad(vertices, rect.getTransform(), { 0, 0, size.x, size.y }, rect.getFillColor());
+    appendOutline(vertices, rect.getTransform(), size, rect.getOutlineThickness(), rect.getOutlineColor());
 }
 // Inherited via Drawable
 void my::Entity::draw(sf::RenderTarget & target, sf::RenderStates states) const {
@@ -1,9 +1,12 @@
 #ifndef ENTITY_HPP
 #define ENTITY_HPP
+/*
+    Description: Render-only sprite or rectangle, for drawing outside the World, e.g. the
+        atlas benchmark. It does not move: the World owns every entity that does.
+*/
 #include <SFML/Graphics.hpp>
 #include <memory>
-#include <unordered_map>
-#include <functional>
+#include "atlas.hpp"
 
 namespace my {
 
@@ -12,12 +15,13 @@ namespace my {
         std::shared_ptr<sf::Texture> texture_ptr;
         sf::Sprite sprite;
         sf::RectangleShape rect;
-        sf::Vector2f target_move, target_action, old_position;
-        float speed, move_percent;
     public:
-        std::unordered_map<sf::Keyboard::Key, std::function<void(void)>> inputs;
-        std::vector <std::function<void(float)>> events;
         Entity(std::shared_ptr<sf::Texture> texture_ptr = 0);
+        //Sprite showing only region.rect of region.texture, e.g. an atlas entry.
+        Entity(const TextureRegion& region);
+        //Swap in a texture after construction, e.g. once an async load completes.
+        void setTexture(std::shared_ptr<sf::Texture> texture_ptr);
+        void setTexture(const TextureRegion& region);
         const sf::Vector2f& getSize();
         void setSize(float x, float y);
         void setSize(const sf::Vector2f& size);
@@ -27,18 +31,12 @@ namespace my {
         void setOutlineColor(const sf::Color& color);
         float getOutlineThickness();
         void setOutlineThickness(float thickness);
-        void setPosition(float x, float y, bool fixed = true);
-        void setPosition(const sf::Vector2f position, bool fixed = true);
+        void setPosition(float x, float y);
+        void setPosition(const sf::Vector2f position);
         const sf::Vector2f getPosition();
-        void setPositionBy(const sf::Vector2f& position, bool fixed = true);
-        void setPositionBy(float x, float y, bool fixed = true);
-        void move(const sf::Vector2f& position);
-        void move(float x, float y);
-        void moveBy(const sf::Vector2f& position);
-        void moveBy(float x, float y);
-        const sf::Vector2f moving();
-        bool isMoving();
-        void move(float delta);
+        const sf::Texture* getTexture() const;
+        //Append this entity's quads (sprite, or rectangle and outline) to a sf::Quads array.
+        void append(sf::VertexArray& vertices) const;
         // Inherited via Drawable
         void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
     };
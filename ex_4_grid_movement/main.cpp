@@ -1,72 +1,377 @@
 /*
     Description:
         Grid Movement design without grid.
+        Streaming mode (--stream) lays a real tile grid underneath, drawn a chunk at a time.
 */
 #include <SFML/Graphics.hpp>
 #include "my.hpp"
+#include "../common/scheduler.hpp"
+#include "../common/profiler.hpp"
+#include "../common/jobs.hpp"
+#include "../common/triplebuffer.hpp"
+#include "../common/camera.hpp"
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
 #include <thread>
 
 
-int main() {
+//Texture binds per frame for sprites distinct small images, each its own texture
+//versus packed into an atlas.
+int benchAtlas(std::size_t sprites) {
+    std::vector<sf::Image> images(sprites);
+    for (std::size_t i = 0; i < sprites; ++i)
+        images[i].create(16 + i % 17, 16 + i % 13, sf::Color(i * 37 % 256, i * 91 % 256, i * 13 % 256));
+
+    std::vector<std::shared_ptr<sf::Texture>> textures;
+    std::vector<my::Entity> separate, packed;
+    my::Atlas atlas{ 1024 };
+    for (std::size_t i = 0; i < sprites; ++i) {
+        textures.push_back(std::make_shared<sf::Texture>());
+        textures.back()->loadFromImage(images[i]);
+        separate.push_back(my::Entity(textures.back()));
+        atlas.add(std::to_string(i), images[i]);
+    }
+    atlas.build();
+    for (std::size_t i = 0; i < sprites; ++i)
+        packed.push_back(my::Entity(atlas.get(std::to_string(i))));
+
+    my::BatchRenderer renderer;
+    for (auto scene : { &separate, &packed }) {
+        renderer.clear();
+        sf::Clock clock;
+        for (const auto& entity : *scene)
+            renderer.add(entity);
+        std::cout << (scene == &separate ? "separate" : "atlas   ") << ": "
+                  << renderer.getBatchCount() << " texture binds/frame, batching took "
+                  << clock.getElapsedTime().asMicroseconds() << "us\n";
+    }
+    std::cout << sprites << " sprites on " << atlas.getPageCount() << " atlas pages\n";
+    return 0;
+}
+
+//Movement updates per second with the move system split over 1 to all cores,
+//in free mode (float targets) and grid mode (integer cells, fixed-point progress).
+int benchJobs(std::size_t entities, std::size_t ticks) {
+    unsigned cores = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+    for (float cell : { 0.f, 10.f }) {
+        my::World world{ cell, 1 / 120.f };
+        world.reserve(entities);
+        for (std::size_t i = 0; i < entities; ++i) {
+            //Slow entities: a cell takes 10000 ticks, so every entity keeps moving for the whole run.
+            my::EntityId id = world.create({ static_cast<float>(i % 80 * 10), static_cast<float>(i / 80 % 60 * 10) }, { 10, 10 });
+            world.speeds[world.index(id)] = 0.012f;
+            world.moveBy(id, { 10, 10 });
+        }
+        std::cout << (cell ? "grid mode\n" : "free mode\n");
+        double single = 0;
+        for (unsigned threads = 1; threads <= cores; ++threads) {
+            my::JobSystem jobs{ threads - 1 };
+            sf::Clock clock;
+            for (std::size_t tick = 0; tick < ticks; ++tick)
+                jobs.parallelFor(world.size(), 4096, [&world](std::size_t begin, std::size_t end) {
+                    world.move(1 / 120.f, begin, end);
+                });
+            double seconds = clock.getElapsedTime().asSeconds(),
+                   rate = seconds > 0 ? entities * ticks / seconds : 0;
+            if (threads == 1)
+                single = rate;
+            std::cout << threads << " threads: " << rate / 1e6 << "M moves/s, "
+                      << (single > 0 ? rate / single : 0) << "x, " << jobs.steals << " steals\n";
+        }
+    }
+    return 0;
+}
+
+//Stand-in tileset when tiles.png is missing: one flat tile per terrain, edged a shade darker.
+std::shared_ptr<sf::Texture> makeTileset(unsigned tileSize) {
+    const sf::Color terrain[] = { { 60, 110, 50 }, { 80, 140, 60 }, { 150, 130, 90 }, { 50, 80, 150 } };
+    sf::Image image;
+    image.create(tileSize * 4, tileSize);
+    for (unsigned t = 0; t < 4; ++t)
+        for (unsigned y = 0; y < tileSize; ++y)
+            for (unsigned x = 0; x < tileSize; ++x) {
+                bool edge = !x || !y;
+                sf::Color c = terrain[t];
+                image.setPixel(t * tileSize + x, y, edge ? sf::Color(c.r * 3 / 4, c.g * 3 / 4, c.b * 3 / 4) : c);
+            }
+    auto texture = std::make_shared<sf::Texture>();
+    texture->loadFromImage(image);
+    return texture;
+}
+
+//Steps wandering entities one grid cell at a time in random directions.
+void wander(my::World& world, std::mt19937& random, std::size_t first) {
+    static const sf::Vector2i directions[] = { { 0, -1 }, { 0, 1 }, { -1, 0 }, { 1, 0 } };
+    std::uniform_int_distribution<int> pick{ 0, 3 };
+    for (std::size_t i = first; i < world.size(); ++i)
+        if (!world.headings[i].x && !world.headings[i].y)
+            world.moveCells(world.id(i), directions[pick(random)]);
+}
+
+int main(int argc, char* argv[]) {
+    //Atlas benchmark: grid --bench-atlas [sprites]
+    if (argc > 1 && std::string{ argv[1] } == "--bench-atlas")
+        return benchAtlas(argc > 2 ? std::stoul(argv[2]) : 300);
+    //Job system scaling: grid --bench-jobs [entities] [ticks]
+    if (argc > 1 && std::string{ argv[1] } == "--bench-jobs")
+        return benchJobs(argc > 2 ? std::stoul(argv[2]) : 1000000, argc > 3 ? std::stoul(argv[3]) : 240);
+    //Stress: grid --entities [count] adds count wandering entities beside the player.
+    std::size_t crowd = argc > 1 && std::string{ argv[1] } == "--entities" ? (argc > 2 ? std::stoul(argv[2]) : 100000) : 0;
+    //Threaded: grid [--entities count] --threaded draws on a second thread from published snapshots.
+    bool threaded = false;
+    for (int i = 1; i < argc; ++i)
+        threaded = threaded || std::string{ argv[i] } == "--threaded";
+    //Streaming: grid --stream [per chunk] walks an endless map paged in and out around the player.
+    bool streaming = argc > 1 && std::string{ argv[1] } == "--stream";
+    std::size_t density = streaming && argc > 2 ? std::stoul(argv[2]) : 64;
+
     sf::RenderWindow window{ sf::VideoMode{800,600},"Game" };
-    std::pair<float, float> updateTimer{ 0.f,1 / 120.f }, drawTimer{ 0.f,1 / 60.f };
+    //Fixed 120 updates per second with catch-up, 60 draws per second.
+    my::Scheduler scheduler{ 120.f, 60.f };
+    my::Profiler profiler;
 
-    std::vector<my::Entity> entities;
-    entities.push_back(my::Entity(my::AssetManager::load("badlogic.jpg")));
-    entities[0].setSize(100,100);
-    entities[0].setOutlineColor(sf::Color::Red);
-    entities[0].setOutlineThickness(-5);
+    //Keep at most 64MB of textures that no entity is using.
+    my::AssetManager::setBudget(64 * 1024 * 1024);
 
-    entities[0].inputs[sf::Keyboard::Up] = [&entities]()->void {
-        if (!entities[0].isMoving())
-            entities[0].moveBy(0, -entities[0].getSize().y);
-    };
-    entities[0].inputs[sf::Keyboard::Down] = [&entities]()->void {
-        if (!entities[0].isMoving())
-            entities[0].moveBy(0, entities[0].getSize().y);
-    };
-    entities[0].inputs[sf::Keyboard::Left] = [&entities]()->void {
-        if (!entities[0].isMoving())
-            entities[0].moveBy(-entities[0].getSize().x, 0);
+    //Components in packed arrays; systems below walk only what they use.
+    //Grid mode on 10 pixel cells: integer cells and fixed-point progress per fixed tick.
+    my::World world{ 10.f, scheduler.getStep() };
+    world.reserve(crowd + 1);
+    //Start untextured; the texture is decoded in the background and applied when ready.
+    my::AssetManager::Handle badlogic = my::AssetManager::loadAsync("badlogic.jpg");
+    my::EntityId player = world.create({ 0, 0 }, { 100, 100 });
+    world.renders[world.index(player)].outline = sf::Color::Red;
+    world.renders[world.index(player)].thickness = -5;
+
+    world.bind(player).bind(sf::Keyboard::Up, [](my::World& world, my::EntityId id)->void {
+        if (!world.isMoving(id))
+            world.moveBy(id, { 0, -world.sizes[world.index(id)].y });
+    });
+    world.bind(player).bind(sf::Keyboard::Down, [](my::World& world, my::EntityId id)->void {
+        if (!world.isMoving(id))
+            world.moveBy(id, { 0, world.sizes[world.index(id)].y });
+    });
+    world.bind(player).bind(sf::Keyboard::Left, [](my::World& world, my::EntityId id)->void {
+        if (!world.isMoving(id))
+            world.moveBy(id, { -world.sizes[world.index(id)].x, 0 });
+    });
+    world.bind(player).bind(sf::Keyboard::Right, [](my::World& world, my::EntityId id)->void {
+        if (!world.isMoving(id))
+            world.moveBy(id, { world.sizes[world.index(id)].x, 0 });
+    });
+
+    std::mt19937 random{ 7 };
+    std::uniform_real_distribution<float> spread{ 0.f, 1.f };
+    for (std::size_t i = 0; i < crowd; ++i) {
+        float x = std::floor(spread(random) * 80) * 10,
+              y = std::floor(spread(random) * 60) * 10;
+        my::EntityId id = world.create({ x, y }, { 10, 10 });
+        world.renders[world.index(id)].fill = sf::Color(i * 37 % 256, i * 91 % 256, i * 13 % 256);
+        world.speeds[world.index(id)] = 4 + spread(random) * 8;
+    }
+
+    //Chunks within two of the player's are resident, entities and all; the rest wait on disk.
+    std::unique_ptr<my::ChunkMap> chunks;
+    if (streaming)
+        chunks.reset(new my::ChunkMap{ 2, density, 7 });
+    //Ground of the resident chunks: one prebuilt vertex buffer and draw call per chunk on screen.
+    std::unique_ptr<my::TileLayer> ground;
+    if (streaming) {
+        std::shared_ptr<sf::Texture> tileset = my::AssetManager::load("tiles.png");
+        ground.reset(new my::TileLayer{ world.getCell(), tileset ? tileset : makeTileset(16), 16 });
+    }
+    //Center of the player: the camera follows it while streaming.
+    auto focus = [&world, player]() {
+        std::size_t i = world.index(player);
+        return world.positions[i] + world.sizes[i] / 2.f;
     };
-    entities[0].inputs[sf::Keyboard::Right] = [&entities]()->void {
-        if (!entities[0].isMoving())
-            entities[0].moveBy(entities[0].getSize().x, 0);
+    //The mouse wheel zooms. Only entities the grid finds in the camera's bounds are drawn.
+    my::Camera camera{ { 0, 0, 800, 600 } };
+    my::SpatialGrid grid{ 40.f };
+    std::vector<std::uint32_t> visible;
+    auto cull = [&]() {
+        if (streaming)
+            camera.follow(focus());
+        grid.build(world.positions, world.sizes);
+        visible.clear();
+        grid.query(camera.getBounds(), visible);
+        camera.count(visible.size(), world.size());
     };
-    entities[0].events.push_back([&entities](float delta)->void {
-        entities[0].move(delta);
-    });
+
+    //Movement runs on every core: entities only touch their own components.
+    my::JobSystem jobs;
+
+    //One draw call per texture instead of one per entity.
+    my::BatchRenderer renderer;
+    std::pair<float, float> printTimer{ 0.f, 1.f };
+    //Counters of the last draw, readable from either thread.
+    std::atomic<std::size_t> drawCalls{ 0 }, vertexCount{ 0 }, frames{ 0 };
+
+    //Threaded mode: the update loop publishes snapshots, the render thread draws the newest.
+    my::TripleBuffer<my::WorldSnapshot> snapshots;
+    std::atomic<bool> drawing{ true };
+    my::Profiler renderProfiler;
+    std::thread drawer;
+    if (threaded) {
+        cull();
+        snapshots.back().capture(world, visible);
+        snapshots.back().view = camera.getView();
+        snapshots.publish();
+        //The context moves to the render thread: it alone draws and displays from here on.
+        window.setActive(false);
+        drawer = std::thread{ [&]() {
+            window.setActive(true);
+            my::Scheduler pacing{ 60.f, 60.f };
+            while (drawing) {
+                pacing.advance();
+                renderProfiler.beginFrame();
+                if (pacing.drawDue()) {
+                    my::Profiler::Scope scope(renderProfiler, my::Phase::Draw);
+                    snapshots.update();
+                    window.setView(snapshots.front().view);
+                    window.clear();
+                    if (ground)
+                        window.draw(*ground);
+                    renderer.clear();
+                    snapshots.front().render(renderer);
+                    renderer.draw(window);
+                    window.display();
+                    drawCalls = renderer.drawCalls;
+                    vertexCount = renderer.vertexCount;
+                    ++frames;
+                }
+                {
+                    my::Profiler::Scope scope(renderProfiler, my::Phase::Sleep);
+                    pacing.wait();
+                }
+                renderProfiler.endFrame();
+            }
+            window.setActive(false);
+        } };
+    }
+
+    //Keyboard sampled once per frame for every key some entity binds.
+    my::Keyboard keyboard;
 
     bool running = true;
     while (running) {
-        my::delta = my::clock.getElapsedTime().asSeconds();
-        my::clock.restart();
+        profiler.beginFrame();
+        std::size_t steps = scheduler.advance();
+        my::delta = scheduler.delta;
         sf::Event event;
+        my::Profiler::Clock::time_point polling = my::Profiler::Clock::now();
         while (window.pollEvent(event)) {
 
-            if(event.type == sf::Event::Closed || sf::Keyboard::isKeyPressed(sf::Keyboard::Escape))
+            if(event.type == sf::Event::Closed ||
+               (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape))
                 running = false;
-            for (std::size_t i = 0; i < entities.size(); ++i) {
-                for (const auto& input : entities[i].inputs) {
-                    if (sf::Keyboard::isKeyPressed(input.first))
-                        input.second();
+            if (event.type == sf::Event::MouseWheelScrolled)
+                camera.zoom(event.mouseWheelScroll.delta > 0 ? 0.9f : 1.1f);
+            //Space cycles the tile under the player: the chunk keeps it, the layer updates it in place.
+            if (chunks && event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Space) {
+                sf::Vector2f center = focus();
+                sf::Vector2i cell{ static_cast<int>(std::floor(center.x / world.getCell())),
+                                   static_cast<int>(std::floor(center.y / world.getCell())) };
+                int tile = chunks->getTile(cell);
+                if (tile >= 0) {
+                    std::uint8_t next = static_cast<std::uint8_t>((tile + 1) % 4);
+                    chunks->setTile(cell, next);
+                    ground->setTile(cell, next);
                 }
             }
         }
-        updateTimer.first += my::delta;
-        if (updateTimer.first > updateTimer.second) {
-            for (std::size_t i = 0; i < entities.size(); ++i)
-                for (const auto& event : entities[i].events)
-                    event(updateTimer.first);
-            while (updateTimer.first > updateTimer.second)
-                updateTimer.first -= updateTimer.second;
+        keyboard.sample(world.getInputMask());
+        world.input(keyboard.state);
+        profiler.add(my::Phase::Events, polling, my::Profiler::Clock::now());
+        //Upload textures decoded since last frame, then hand them to their entities.
+        if (my::AssetManager::update() && badlogic.valid() && my::AssetManager::ready(badlogic)) {
+            world.setTexture(player, badlogic.get());
+            badlogic = my::AssetManager::Handle{};
+        }
+        bool ticked = steps > 0;
+        while (steps--) {
+            my::Profiler::Scope scope(profiler, my::Phase::Update);
+            wander(world, random, 1);
+            float step = scheduler.getStep();
+            jobs.parallelFor(world.size(), 4096, [&world, step](std::size_t begin, std::size_t end) {
+                world.move(step, begin, end);
+            });
+        }
+        if (chunks && ticked) {
+            my::Profiler::Scope scope(profiler, my::Phase::Update);
+            chunks->update(world, focus(), player);
+            for (const sf::Vector2i& coordinate : chunks->getAdmitted())
+                ground->set(coordinate, chunks->find(coordinate)->tiles);
+            for (const sf::Vector2i& coordinate : chunks->getEvicted())
+                ground->remove(coordinate);
+        }
+        if (threaded && ticked) {
+            //One snapshot per frame: only the last tick's positions would be drawn.
+            //Culled first, so the copy and the other thread's work follow what is visible.
+            my::Profiler::Scope scope(profiler, my::Phase::Update);
+            cull();
+            snapshots.back().capture(world, visible);
+            snapshots.back().view = camera.getView();
+            snapshots.publish();
+        }
+        if (!threaded && scheduler.drawDue()) {
+            my::Profiler::Scope scope(profiler, my::Phase::Draw);
+            cull();
+            camera.apply(window);
+            window.clear();
+            if (ground)
+                window.draw(*ground);
+            renderer.clear();
+            world.render(renderer, visible);
+            renderer.draw(window);
+            window.display();
+            drawCalls = renderer.drawCalls;
+            vertexCount = renderer.vertexCount;
+            ++frames;
         }
-        window.clear();
-        for (const auto& entity : entities)
-            window.draw(entity);
-        window.display();
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int>(1000/240)));
+        printTimer.first += my::delta;
+        if (printTimer.first > printTimer.second) {
+            const my::AssetManager::Stats& assets = my::AssetManager::getStats();
+            std::cout << world.size() << " entities, " << frames.exchange(0) << " frames, "
+                      << drawCalls << " draw calls, " << vertexCount << " vertices, "
+                      << assets.textures << " textures " << assets.residentBytes << " bytes, "
+                      << assets.hits << " hits " << assets.misses << " misses "
+                      << assets.evictions << " evictions, "
+                      << camera.visible << '/' << camera.total << " visible\n";
+            if (chunks) {
+                my::ChunkMap::Stats stream = chunks->getStats();
+                std::cout << stream.resident << " chunks resident in " << stream.residentBytes << " bytes, "
+                          << stream.loading << " loading, " << stream.loads << " loads " << stream.saves << " saves "
+                          << stream.generated << " generated, " << stream.diskBytes << " bytes written\n";
+                my::TileLayer::Stats tiles = ground->getStats();
+                std::cout << tiles.chunks << " ground chunks, " << tiles.drawCalls << " ground draw calls, "
+                          << tiles.bakes << " bakes, " << tiles.vertexUploads << " vertices uploaded\n";
+            }
+            printTimer.first -= printTimer.second;
+            profiler.print(std::cout);
+            if (threaded)
+                renderProfiler.print(std::cout);
+        }
+
+        {
+            my::Profiler::Scope scope(profiler, my::Phase::Sleep);
+            scheduler.wait();
+        }
+        profiler.endFrame();
+    }
+    if (threaded) {
+        drawing = false;
+        drawer.join();
+        window.setActive(true);
     }
+    //Resident chunks go to disk too, so the next run walks the same map.
+    if (chunks)
+        chunks->save(world, player);
+    profiler.writeCsv("profile.csv");
+    profiler.writeTrace("profile.json");
     return 0;
 }
\ No newline at end of file
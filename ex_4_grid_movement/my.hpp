@@ -5,7 +5,13 @@ namespace my {
     float delta = 0;
     sf::Clock clock;
 }
+#include "atlas.hpp"
 #include "assetmanager.hpp"
 #include "entity.hpp"
+#include "batchrenderer.hpp"
+#include "world.hpp"
+#include "chunkmap.hpp"
+#include "spatialgrid.hpp"
+#include "tilelayer.hpp"
 
 #endif // !MY_HPP
@@ -0,0 +1,77 @@
+#include "spatialgrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+my::SpatialGrid::SpatialGrid(float cell) :
+    cell{ cell }, size{ cell }, columns{ 0 }, rows{ 0 }, positions{ nullptr }, sizes{ nullptr } {}
+void my::SpatialGrid::build(const std::vector<sf::Vector2f>& positions, const std::vector<sf::Vector2f>& sizes) {
+    this->positions = positions.data();
+    this->sizes = sizes.data();
+    std::size_t count = positions.size();
+    keys.resize(count);
+    entries.resize(count);
+    columns = rows = 0;
+    if (!count)
+        return;
+    sf::Vector2f low = positions[0], high = positions[0];
+    largest = sf::Vector2f{};
+    for (std::size_t i = 0; i < count; ++i) {
+        low = sf::Vector2f{ std::min(low.x, positions[i].x), std::min(low.y, positions[i].y) };
+        high = sf::Vector2f{ std::max(high.x, positions[i].x), std::max(high.y, positions[i].y) };
+        largest = sf::Vector2f{ std::max(largest.x, sizes[i].x), std::max(largest.y, sizes[i].y) };
+    }
+    //Double the cells until there are at most four per entity.
+    double limit = 4.0 * count + 64;
+    size = cell;
+    for (;;) {
+        origin = sf::Vector2i{ static_cast<int>(std::floor(low.x / size)), static_cast<int>(std::floor(low.y / size)) };
+        columns = static_cast<int>(std::floor(high.x / size)) - origin.x + 1;
+        rows = static_cast<int>(std::floor(high.y / size)) - origin.y + 1;
+        if (static_cast<double>(columns) * rows <= limit)
+            break;
+        size *= 2;
+    }
+
+    //Counting sort: count per cell, prefix sum into starts, then place.
+    starts.assign(static_cast<std::size_t>(columns) * rows + 1, 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        int x = static_cast<int>(std::floor(positions[i].x / size)) - origin.x,
+            y = static_cast<int>(std::floor(positions[i].y / size)) - origin.y;
+        keys[i] = static_cast<std::uint32_t>(y * columns + x);
+        ++starts[keys[i] + 1];
+    }
+    for (std::size_t c = 1; c < starts.size(); ++c)
+        starts[c] += starts[c - 1];
+    std::vector<std::uint32_t>& next = keys;//Reused: each key becomes its slot in entries.
+    std::vector<std::uint32_t> fill{ starts.begin(), starts.end() - 1 };
+    for (std::size_t i = 0; i < count; ++i)
+        next[i] = fill[keys[i]]++;
+    for (std::size_t i = 0; i < count; ++i)
+        entries[next[i]] = static_cast<std::uint32_t>(i);
+}
+void my::SpatialGrid::query(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const {
+    if (!columns)
+        return;
+    std::size_t first = out.size();
+    //An entity is filed under its top-left corner: look back by the largest size.
+    auto column = [this](float x) { return std::min(std::max(static_cast<int>(std::floor(x / size)) - origin.x, 0), columns - 1); };
+    auto row = [this](float y) { return std::min(std::max(static_cast<int>(std::floor(y / size)) - origin.y, 0), rows - 1); };
+    float right = area.left + area.width, bottom = area.top + area.height;
+    if (right < origin.x * size || bottom < origin.y * size ||
+        area.left - largest.x > (origin.x + columns) * size || area.top - largest.y > (origin.y + rows) * size)
+        return;
+    int left = column(area.left - largest.x), top = row(area.top - largest.y),
+        last = column(right), lowest = row(bottom);
+    for (int y = top; y <= lowest; ++y) {
+        std::uint32_t begin = starts[y * columns + left], end = starts[y * columns + last + 1];
+        //Cells of a row are adjacent in entries: one run per row.
+        for (std::uint32_t e = begin; e < end; ++e) {
+            std::uint32_t i = entries[e];
+            const sf::Vector2f& p = positions[i];
+            const sf::Vector2f& s = sizes[i];
+            if (p.x < right && area.left < p.x + s.x && p.y < bottom && area.top < p.y + s.y)
+                out.push_back(i);
+        }
+    }
+    std::sort(out.begin() + first, out.end());
+}
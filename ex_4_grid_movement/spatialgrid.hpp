@@ -0,0 +1,36 @@
+#ifndef SPATIALGRID_HPP
+#define SPATIALGRID_HPP
+/*
+    Description: Grid index over packed entity positions, for culling. build() buckets every
+        entity by the cell of its top-left corner with one counting sort into a dense grid
+        over the area the entities cover; query() visits only the cells under a rectangle.
+        Building is two linear passes over the positions; everything after the query, from
+        quads to draw calls, grows with what is inside the rectangle and not with the world.
+        Entities larger than a cell are still found: queries are widened by the largest size.
+*/
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace my {
+    class SpatialGrid {
+    private:
+        float cell, size;           //Requested cell size, and the one in use after coarsening.
+        sf::Vector2i origin;        //Cell of the grid's top-left corner.
+        int columns, rows;
+        sf::Vector2f largest;
+        std::vector<std::uint32_t> keys;    //Cell of each entity, scratch for the sort.
+        std::vector<std::uint32_t> starts;  //First entry of each cell, and one past the last.
+        std::vector<std::uint32_t> entries; //Packed indices, grouped by cell.
+        const sf::Vector2f* positions;
+        const sf::Vector2f* sizes;
+    public:
+        explicit SpatialGrid(float cell);
+        //Positions and sizes are read again by query: rebuild after they change.
+        //A spread-out world gets coarser cells so the grid never has many more cells than entities.
+        void build(const std::vector<sf::Vector2f>& positions, const std::vector<sf::Vector2f>& sizes);
+        //Appends the packed index of every entity overlapping area, in ascending order.
+        void query(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const;
+    };
+}
+#endif // !SPATIALGRID_HPP
@@ -0,0 +1,99 @@
+#include "tilelayer.hpp"
+#include "../common/camera.hpp"
+#include <utility>
+
+my::TileLayer::TileLayer(float cell, std::shared_ptr<sf::Texture> tileset, unsigned tileSize) :
+    cell{ cell }, tileset{ tileset }, tileSize{ tileSize },
+    columns{ tileset && tileSize ? tileset->getSize().x / tileSize : 0 }, stats{ 0, 0, 0, 0 } {
+    columns = columns ? columns : 1;
+}
+void my::TileLayer::bake(Block& block, std::size_t tile) {
+    std::size_t x = tile % Chunk::side, y = tile / Chunk::side;
+    sf::Vector2f corner{ (block.coordinate.x * Chunk::side + static_cast<int>(x)) * cell,
+                         (block.coordinate.y * Chunk::side + static_cast<int>(y)) * cell };
+    unsigned id = block.tiles[tile];
+    sf::Vector2f texture{ static_cast<float>(id % columns * tileSize), static_cast<float>(id / columns * tileSize) };
+    float size = static_cast<float>(tileSize);
+    const sf::Vector2f offsets[6] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 0 }, { 1, 1 }, { 0, 1 } };
+    for (std::size_t k = 0; k < 6; ++k) {
+        sf::Vertex& vertex = block.vertices[tile * 6 + k];
+        vertex.position = corner + offsets[k] * cell;
+        vertex.texCoords = texture + offsets[k] * size;
+        vertex.color = sf::Color::White;
+    }
+}
+void my::TileLayer::set(const sf::Vector2i& coordinate, const std::vector<std::uint8_t>& tiles) {
+    std::unique_ptr<Block> block{ new Block };
+    block->coordinate = coordinate;
+    block->tiles = tiles;
+    block->tiles.resize(Chunk::side * Chunk::side);
+    block->vertices = sf::VertexArray{ sf::Triangles, block->tiles.size() * 6 };
+    for (std::size_t tile = 0; tile < block->tiles.size(); ++tile)
+        bake(*block, tile);
+    //No GL work here: the buffer is created by the first draw, on the drawing thread.
+    block->buffer.setPrimitiveType(sf::Triangles);
+    block->buffer.setUsage(sf::VertexBuffer::Static);
+    block->uploaded = false;
+    std::lock_guard<std::mutex> lock{ mutex };
+    blocks[ChunkMap::key(coordinate)] = std::move(block);
+    ++stats.bakes;
+}
+void my::TileLayer::remove(const sf::Vector2i& coordinate) {
+    std::lock_guard<std::mutex> lock{ mutex };
+    blocks.erase(ChunkMap::key(coordinate));
+}
+bool my::TileLayer::setTile(const sf::Vector2i& cell, std::uint8_t tile) {
+    sf::Vector2i coordinate = ChunkMap::chunkOf(cell);
+    std::lock_guard<std::mutex> lock{ mutex };
+    auto it = blocks.find(ChunkMap::key(coordinate));
+    if (it == blocks.end())
+        return false;
+    Block& block = *it->second;
+    std::size_t index = (cell.y - coordinate.y * Chunk::side) * Chunk::side + (cell.x - coordinate.x * Chunk::side);
+    if (block.tiles[index] == tile)
+        return true;
+    block.tiles[index] = tile;
+    bake(block, index);
+    block.dirty.push_back(static_cast<std::uint16_t>(index));
+    return true;
+}
+my::TileLayer::Stats my::TileLayer::getStats() const {
+    std::lock_guard<std::mutex> lock{ mutex };
+    Stats copy = stats;
+    copy.chunks = blocks.size();
+    return copy;
+}
+// Inherited via Drawable
+void my::TileLayer::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    states.texture = tileset.get();
+    sf::FloatRect view = Camera::getBounds(target.getView());
+    float extent = Chunk::side * cell;
+    bool buffered = sf::VertexBuffer::isAvailable();
+    std::lock_guard<std::mutex> lock{ mutex };
+    stats.drawCalls = 0;
+    for (const auto& entry : blocks) {
+        Block& block = *entry.second;
+        if (!view.intersects({ block.coordinate.x * extent, block.coordinate.y * extent, extent, extent }))
+            continue;
+        ++stats.drawCalls;
+        if (!buffered) {
+            block.dirty.clear();
+            target.draw(block.vertices, states);
+            continue;
+        }
+        if (!block.uploaded) {
+            block.buffer.create(block.vertices.getVertexCount());
+            block.buffer.update(&block.vertices[0]);
+            block.uploaded = true;
+            block.dirty.clear();
+            stats.vertexUploads += block.vertices.getVertexCount();
+        }
+        //Edited tiles only: six vertices each, written over their old ones.
+        for (std::uint16_t tile : block.dirty) {
+            block.buffer.update(&block.vertices[tile * 6], 6, tile * 6);
+            stats.vertexUploads += 6;
+        }
+        block.dirty.clear();
+        target.draw(block.buffer, states);
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef TILELAYER_HPP
+#define TILELAYER_HPP
+/*
+    Description: Ground tiles of a grid world, drawn one chunk per draw call. Chunks are laid
+        out as in ChunkMap, Chunk::side tiles to a side. Each chunk's tile ids sit in a flat
+        row-major array and are baked once into a triangle list textured from a tileset,
+        uploaded to a static vertex buffer where supported.
+        Nothing is rebuilt per frame: a chunk is baked when it is set, and a tile edit
+        rewrites that tile's six vertices in place and uploads only those on the next draw.
+        Draw skips chunks outside the target's current view.
+        Edits and draws lock the layer, so they may come from different threads.
+*/
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "chunkmap.hpp"
+
+namespace my {
+    class TileLayer : public sf::Drawable {
+    public:
+        struct Stats {
+            std::size_t chunks, drawCalls;  //Chunks held, and drawn by the last draw.
+            std::size_t bakes, vertexUploads;//Since start: whole chunks baked, vertices uploaded.
+        };
+    private:
+        struct Block {
+            sf::Vector2i coordinate;
+            std::vector<std::uint8_t> tiles;
+            sf::VertexArray vertices;
+            //Uploaded lazily by the drawing thread: whole once, then only the dirty tiles.
+            sf::VertexBuffer buffer;
+            bool uploaded;
+            std::vector<std::uint16_t> dirty;
+        };
+        float cell;
+        std::shared_ptr<sf::Texture> tileset;
+        unsigned tileSize, columns;
+        std::unordered_map<std::uint64_t, std::unique_ptr<Block>> blocks;
+        mutable Stats stats;
+        mutable std::mutex mutex;
+        void bake(Block& block, std::size_t tile);
+    public:
+        //cell: pixels per tile in the world; tileSize: pixels per tile in the tileset,
+        //whose tiles are numbered row by row.
+        TileLayer(float cell, std::shared_ptr<sf::Texture> tileset, unsigned tileSize);
+        //Bakes a chunk from Chunk::side * Chunk::side tile ids, replacing it if already held.
+        void set(const sf::Vector2i& coordinate, const std::vector<std::uint8_t>& tiles);
+        void remove(const sf::Vector2i& coordinate);
+        //Changes the tile at cell in a held chunk; false when its chunk is not held.
+        bool setTile(const sf::Vector2i& cell, std::uint8_t tile);
+        Stats getStats() const;
+    protected:
+        // Inherited via Drawable
+        void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    };
+}
+#endif // !TILELAYER_HPP
@@ -0,0 +1,261 @@
+#include "world.hpp"
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+const std::uint32_t my::World::none;
+const std::uint32_t my::World::one;
+
+my::World::World() : World{ 0.f, 0.f } {}
+my::World::World(float cell, float step) : freeSlot{ none }, cell{ cell }, step{ step } {}
+void my::World::reserve(std::size_t count) {
+    ids.reserve(count);
+    slots.reserve(count);
+    positions.reserve(count);
+    origins.reserve(count);
+    targets.reserve(count);
+    sizes.reserve(count);
+    speeds.reserve(count);
+    renders.reserve(count);
+    cells.reserve(count);
+    headings.reserve(count);
+    progress.reserve(count);
+    rates.reserve(count);
+}
+my::EntityId my::World::create(const sf::Vector2f& position, const sf::Vector2f& size) {
+    EntityId id;
+    if (freeSlot != none) {
+        id = freeSlot;
+        freeSlot = slots[id];
+    }
+    else {
+        id = static_cast<EntityId>(slots.size());
+        slots.push_back(none);
+    }
+    slots[id] = static_cast<std::uint32_t>(ids.size());
+    ids.push_back(id);
+    sf::Vector2i at;
+    sf::Vector2f snapped{ position };
+    if (cell) {
+        at = sf::Vector2i{ static_cast<int>(std::lround(position.x / cell)), static_cast<int>(std::lround(position.y / cell)) };
+        snapped = sf::Vector2f{ at.x * cell, at.y * cell };
+    }
+    cells.push_back(at);
+    headings.push_back(sf::Vector2i{});
+    progress.push_back(0);
+    rates.push_back(0);
+    positions.push_back(snapped);
+    origins.push_back(snapped);
+    targets.push_back(snapped);
+    sizes.push_back(size);
+    speeds.push_back(1.f);
+    renders.push_back(Render{ nullptr, sf::IntRect{}, sf::Color::White, sf::Color::White, 0.f });
+    return id;
+}
+void my::World::destroy(EntityId id) {
+    if (!alive(id))
+        return;
+    std::size_t i = slots[id], last = ids.size() - 1;
+    if (i != last) {
+        ids[i] = ids[last];
+        positions[i] = positions[last];
+        origins[i] = origins[last];
+        targets[i] = targets[last];
+        sizes[i] = sizes[last];
+        speeds[i] = speeds[last];
+        renders[i] = std::move(renders[last]);
+        cells[i] = cells[last];
+        headings[i] = headings[last];
+        progress[i] = progress[last];
+        rates[i] = rates[last];
+        slots[ids[i]] = static_cast<std::uint32_t>(i);
+    }
+    ids.pop_back();
+    positions.pop_back();
+    origins.pop_back();
+    targets.pop_back();
+    sizes.pop_back();
+    speeds.pop_back();
+    renders.pop_back();
+    cells.pop_back();
+    headings.pop_back();
+    progress.pop_back();
+    rates.pop_back();
+    for (std::size_t j = 0; j < inputs.size(); ++j)
+        if (inputs[j].id == id) {
+            inputs[j] = inputs.back();
+            inputs.pop_back();
+            break;
+        }
+    //Freed ids chain through their slot until reused.
+    slots[id] = freeSlot;
+    freeSlot = id;
+}
+bool my::World::alive(EntityId id) const {
+    return id < slots.size() && slots[id] < ids.size() && ids[slots[id]] == id;
+}
+std::size_t my::World::index(EntityId id) const {
+    return slots[id];
+}
+my::EntityId my::World::id(std::size_t index) const {
+    return ids[index];
+}
+std::size_t my::World::size() const {
+    return ids.size();
+}
+float my::World::getCell() const {
+    return cell;
+}
+void my::World::moveBy(EntityId id, const sf::Vector2f& offset) {
+    if (cell) {
+        moveCells(id, { static_cast<int>(std::lround(offset.x / cell)), static_cast<int>(std::lround(offset.y / cell)) });
+        return;
+    }
+    std::size_t i = slots[id];
+    targets[i] += offset;
+    origins[i] = positions[i];
+}
+void my::World::moveCells(EntityId id, const sf::Vector2i& offset) {
+    std::size_t i = slots[id];
+    cells[i] += headings[i];
+    headings[i] = offset;
+    progress[i] = 0;
+    //A move takes 1 / speed seconds whatever its length, as in free mode; at least one tick.
+    double perTick = std::ceil(static_cast<double>(one) * speeds[i] * step);
+    rates[i] = perTick < 1 ? 1 : perTick > one ? one : static_cast<std::uint32_t>(perTick);
+    positions[i] = sf::Vector2f{ cells[i].x * cell, cells[i].y * cell };
+}
+bool my::World::isMoving(EntityId id) const {
+    std::size_t i = slots[id];
+    if (cell)
+        return headings[i].x || headings[i].y;
+    sf::Vector2i d{ targets[i] - origins[i] };
+    return d.x || d.y;
+}
+void my::World::setTexture(EntityId id, const TextureRegion& region) {
+    Render& render = renders[slots[id]];
+    render.texture = region.texture;
+    render.rect = region.rect;
+}
+void my::World::setTexture(EntityId id, std::shared_ptr<sf::Texture> texture) {
+    sf::IntRect rect;
+    if (texture)
+        rect = sf::IntRect{ 0, 0, static_cast<int>(texture->getSize().x), static_cast<int>(texture->getSize().y) };
+    setTexture(id, TextureRegion{ texture, rect });
+}
+my::BindingTable<my::World::Command>& my::World::bind(EntityId id) {
+    for (auto& input : inputs)
+        if (input.id == id)
+            return input.bindings;
+    inputs.push_back(Input{ id, BindingTable<Command>{} });
+    return inputs.back().bindings;
+}
+my::KeyState my::World::getInputMask() const {
+    KeyState mask;
+    for (const auto& input : inputs)
+        mask |= input.bindings.getMask();
+    return mask;
+}
+void my::World::input(const KeyState& state) {
+    //By index: a command may bind further entities and grow inputs.
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        EntityId id = inputs[i].id;
+        inputs[i].bindings.forEachHeld(state, [this, id](sf::Keyboard::Key, Command command) {
+            command(*this, id);
+        });
+    }
+}
+void my::World::move(float delta) {
+    move(delta, 0, positions.size());
+}
+void my::World::move(float delta, std::size_t begin, std::size_t end) {
+    if (cell) {
+        moveGrid(begin, end);
+        return;
+    }
+    for (std::size_t i = begin; i < end; ++i) {
+        //Whole-pixel distance to the target: zero when standing still.
+        sf::Vector2f d{ sf::Vector2i{ targets[i] - origins[i] } };
+        if (!d.x && !d.y)
+            continue;
+        positions[i] += d * (delta * speeds[i]);
+        sf::Vector2f left{ targets[i] - positions[i] };
+        sf::Vector2i whole{ left };
+        //Arrived, or a fast entity stepped past the target.
+        if ((!whole.x && !whole.y) || left.x * d.x + left.y * d.y <= 0) {
+            positions[i] = targets[i];
+            origins[i] = targets[i];
+        }
+    }
+}
+void my::World::moveGrid(std::size_t begin, std::size_t end) {
+    //Pixels per cell per unit of progress: the only float left, applied once per moving entity.
+    float scale = cell / one;
+    for (std::size_t i = begin; i < end; ++i) {
+        if (!headings[i].x && !headings[i].y)
+            continue;
+        progress[i] += rates[i];
+        if (progress[i] >= one) {
+            cells[i] += headings[i];
+            headings[i] = sf::Vector2i{};
+            progress[i] = 0;
+        }
+        std::int64_t x = static_cast<std::int64_t>(cells[i].x) * one + static_cast<std::int64_t>(headings[i].x) * progress[i],
+                     y = static_cast<std::int64_t>(cells[i].y) * one + static_cast<std::int64_t>(headings[i].y) * progress[i];
+        positions[i] = sf::Vector2f{ x * scale, y * scale };
+    }
+}
+namespace {
+    //Quads of one entity into the batch of its texture.
+    void append(my::BatchRenderer& renderer, const sf::Texture*& texture, sf::VertexArray*& vertices,
+                const sf::Vector2f& position, const sf::Vector2f& size, const my::World::Render& render) {
+        //Entities sharing a texture tend to sit together: skip the batch lookup then.
+        if (render.texture.get() != texture) {
+            texture = render.texture.get();
+            vertices = &renderer.batch(texture);
+        }
+        sf::Transform transform;
+        transform.translate(position);
+        if (texture) {
+            my::appendQuad(*vertices, transform, { 0, 0, size.x, size.y }, render.fill, sf::FloatRect{ render.rect });
+            return;
+        }
+        my::appendQuad(*vertices, transform, { 0, 0, size.x, size.y }, render.fill);
+        my::appendOutline(*vertices, transform, size, render.thickness, render.outline);
+    }
+    //Quads for count entities, shared by the world and its snapshots.
+    void render(my::BatchRenderer& renderer, const sf::Vector2f* positions, const sf::Vector2f* sizes,
+                const my::World::Render* renders, std::size_t count) {
+        const sf::Texture* texture = nullptr;
+        sf::VertexArray* vertices = &renderer.batch(texture);
+        for (std::size_t i = 0; i < count; ++i)
+            append(renderer, texture, vertices, positions[i], sizes[i], renders[i]);
+    }
+}
+void my::World::render(BatchRenderer& renderer) const {
+    ::render(renderer, positions.data(), sizes.data(), renders.data(), positions.size());
+}
+void my::WorldSnapshot::capture(const World& world) {
+    positions.assign(world.positions.begin(), world.positions.end());
+    sizes.assign(world.sizes.begin(), world.sizes.end());
+    renders.assign(world.renders.begin(), world.renders.end());
+}
+void my::World::render(BatchRenderer& renderer, const std::vector<std::uint32_t>& indices) const {
+    const sf::Texture* texture = nullptr;
+    sf::VertexArray* vertices = &renderer.batch(texture);
+    for (std::uint32_t i : indices)
+        ::append(renderer, texture, vertices, positions[i], sizes[i], renders[i]);
+}
+void my::WorldSnapshot::capture(const World& world, const std::vector<std::uint32_t>& indices) {
+    positions.resize(indices.size());
+    sizes.resize(indices.size());
+    renders.resize(indices.size());
+    for (std::size_t j = 0; j < indices.size(); ++j) {
+        positions[j] = world.positions[indices[j]];
+        sizes[j] = world.sizes[indices[j]];
+        renders[j] = world.renders[indices[j]];
+    }
+}
+void my::WorldSnapshot::render(BatchRenderer& renderer) const {
+    ::render(renderer, positions.data(), sizes.data(), renders.data(), positions.size());
+}
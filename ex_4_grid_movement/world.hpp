@@ -0,0 +1,110 @@
+#ifndef WORLD_HPP
+#define WORLD_HPP
+/*
+    Description: Entity component store. Each component lives in its own packed array
+        indexed alike, so a system walks only the arrays it needs. Ids stay stable
+        while entities are destroyed and the arrays are compacted.
+        Grid mode keeps whole cells as integers and the way through the current move as
+        fixed-point progress: arrival is an integer compare that lands exactly on the
+        cell, and the same inputs give the same cells on every machine.
+*/
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "../common/bindings.hpp"
+#include "atlas.hpp"
+#include "batchrenderer.hpp"
+
+namespace my {
+    typedef std::uint32_t EntityId;
+
+    class World {
+    public:
+        //Input handlers get the world and the entity they were bound for.
+        typedef void (*Command)(World& world, EntityId id);
+        //How an entity is drawn: a textured region, or a filled and outlined rectangle.
+        struct Render {
+            std::shared_ptr<sf::Texture> texture;
+            sf::IntRect rect;
+            sf::Color fill, outline;
+            float thickness;
+        };
+    private:
+        //Entity at each packed index, and packed index (or free list link) per id.
+        std::vector<EntityId> ids;
+        std::vector<std::uint32_t> slots;
+        std::uint32_t freeSlot;
+        //Input is sparse: only the few entities with bindings carry one.
+        struct Input {
+            EntityId id;
+            BindingTable<Command> bindings;
+        };
+        std::vector<Input> inputs;
+        //Grid mode: cell size in pixels (0 moves freely), and the fixed tick speeds are per.
+        float cell, step;
+    public:
+        static const std::uint32_t none = 0xFFFFFFFF;
+        //Fixed-point progress of a whole move.
+        static const std::uint32_t one = 1 << 16;
+        //Components, one entry per live entity, all in the same order.
+        std::vector<sf::Vector2f> positions, origins, targets, sizes;
+        std::vector<float> speeds;
+        std::vector<Render> renders;
+        //Grid mode: cell moved from, cells still to go, progress out of one and progress per tick.
+        std::vector<sf::Vector2i> cells, headings;
+        std::vector<std::uint32_t> progress, rates;
+
+        World();
+        //Grid mode: positions snap to cells of cell pixels, move() advances one tick of step seconds.
+        World(float cell, float step);
+        void reserve(std::size_t count);
+        EntityId create(const sf::Vector2f& position, const sf::Vector2f& size);
+        //Swap the last entity into the hole: packed indices change, ids do not.
+        void destroy(EntityId id);
+        bool alive(EntityId id) const;
+        std::size_t index(EntityId id) const;
+        EntityId id(std::size_t index) const;
+        std::size_t size() const;
+        //Cell size in pixels, 0 outside grid mode.
+        float getCell() const;
+
+        //Grid movement: start moving by offset from where the entity stands.
+        //In grid mode offset is rounded to whole cells, and a move still running lands first.
+        void moveBy(EntityId id, const sf::Vector2f& offset);
+        void moveCells(EntityId id, const sf::Vector2i& offset);
+        bool isMoving(EntityId id) const;
+        void setTexture(EntityId id, const TextureRegion& region);
+        void setTexture(EntityId id, std::shared_ptr<sf::Texture> texture);
+        BindingTable<Command>& bind(EntityId id);
+        //Every key some entity binds, for sampling the keyboard once.
+        KeyState getInputMask() const;
+
+        //Systems
+        //Run bound commands for held keys.
+        void input(const KeyState& state);
+        //Advance moving entities toward their targets: positions, origins, targets, speeds only.
+        void move(float delta);
+        //The same over packed indices [begin, end): disjoint ranges may run on different threads.
+        void move(float delta, std::size_t begin, std::size_t end);
+        //Grid mode move: integer progress only, positions written for moving entities alone.
+        void moveGrid(std::size_t begin, std::size_t end);
+        //Append every entity's quads to the renderer: positions, sizes, renders only.
+        void render(BatchRenderer& renderer) const;
+        //The same for the listed packed indices only, as a culling pass leaves them.
+        void render(BatchRenderer& renderer, const std::vector<std::uint32_t>& indices) const;
+    };
+
+    //What drawing needs from a world, copied out so another thread can draw it while the world moves on.
+    struct WorldSnapshot {
+        std::vector<sf::Vector2f> positions, sizes;
+        std::vector<World::Render> renders;
+        sf::View view;//What the camera showed when captured.
+        //Copy into the existing storage: no allocation once sizes settle.
+        void capture(const World& world);
+        //Copy only the listed packed indices: a culled snapshot costs what is visible.
+        void capture(const World& world, const std::vector<std::uint32_t>& indices);
+        void render(BatchRenderer& renderer) const;
+    };
+}
+#endif // !WORLD_HPP